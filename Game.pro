@@ -15,7 +15,10 @@ TARGET = Game
 
 CONFIG += sailfishapp
 
-SOURCES += src/Game.cpp
+SOURCES += src/Game.cpp \
+    src/GameEngine.cpp \
+    src/GameModels.cpp \
+    src/GameWorld.cpp
 
 OTHER_FILES += qml/Game.qml \
     qml/cover/CoverPage.qml \
@@ -47,9 +50,11 @@ DISTFILES += \
     qml/Particle.qml \
     qml/Controller.qml \
     qml/Entity.qml \
-    qml/EntityManager.qml \
     qml/VirusesDemo.qml \
     qml/Particle.qml
 
-HEADERS +=
+HEADERS += \
+    src/GameEngine.h \
+    src/GameModels.h \
+    src/GameWorld.h
 
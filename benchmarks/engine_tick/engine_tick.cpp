@@ -0,0 +1,167 @@
+// Benchmark: fixed steps of the game world per second as the count of
+// entities grows, without Qt and without rendering.
+//
+// Entities are spread over a scene that grows with their count (the density
+// of the 640x480 scene of the game). A quarter of the entities have a particle
+// in flight: particles are launched every step so that arrivals and launches
+// balance, each arrival is a hit-test of the uniform grid. Besides, a few
+// touches per step are hit-tested.
+//
+// Hit-tests of the grid are also compared with the linear scan that
+// EntityManager.qml did for every touch and arrival.
+//
+// Usage: engine_tick [entities count]...
+// By default 100, 1000, 10000 and 100000 entities.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "GameWorld.h"
+
+// Distance between entities, px.
+#define BENCH_PITCH 120
+// Touches per step.
+#define BENCH_TOUCHES 4
+// Minimal measured time, s.
+#define BENCH_MIN_TIME 0.5
+#define BENCH_HIT_TESTS 100000
+
+static unsigned int bench_seed = 1;
+
+static int bench_random(int max)
+{
+    bench_seed = bench_seed * 1103515245u + 12345u;
+    return int((bench_seed >> 8) % unsigned(max));
+}
+
+static double bench_now()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void fill_world(GameWorld &world, int count)
+{
+    int columns = 1;
+
+    while (columns * columns * 3 < count * 4)
+        ++columns;
+
+    world.clear();
+    world.resize(float(columns * BENCH_PITCH), float((count / columns + 1) * BENCH_PITCH));
+
+    for (int i = 0; i < count; ++i) {
+        float x = float((i % columns) * BENCH_PITCH + bench_random(BENCH_PITCH - GameWorld::EntitySize));
+        float y = float((i / columns) * BENCH_PITCH + bench_random(BENCH_PITCH - GameWorld::EntitySize));
+
+        world.addEntity(x, y, 1 + bench_random(2), 10 + bench_random(30));
+    }
+}
+
+static void launch(GameWorld &world)
+{
+    int from = bench_random(world.entityCount());
+    int to = bench_random(world.entityCount());
+
+    world.launchParticle(world.entityX(from) + GameWorld::EntitySize, world.entityY(from) + GameWorld::EntitySize,
+                         world.entityX(to), world.entityY(to),
+                         world.takeCharge(from), world.entityPlayer(from));
+}
+
+static int linear_entity_at(const GameWorld &world, float x, float y)
+{
+    int found = -1;
+
+    for (int i = 0; i < world.entityCount(); ++i) {
+        if (x >= world.entityX(i) && x <= world.entityX(i) + GameWorld::EntitySize
+                && y >= world.entityY(i) && y <= world.entityY(i) + GameWorld::EntitySize)
+            found = i;
+    }
+
+    return found;
+}
+
+static void run(int count)
+{
+    GameWorld world;
+    int flying = count / 4 > 0 ? count / 4 : 1;
+    int steps_per_flight = GameWorld::ParticleFlightMs / GameWorld::StepMs;
+    long steps = 0;
+    long checksum = 0;
+    double start = 0, elapsed = 0;
+    double grid_ns = 0, linear_ns = 0;
+    int linear_tests = 0;
+    std::vector<float> points;
+
+    fill_world(world, count);
+
+    // Warm up until particles in flight are spread over the whole flight.
+    for (int i = 0; i < steps_per_flight; ++i) {
+        for (int k = i * flying / steps_per_flight; k < (i + 1) * flying / steps_per_flight; ++k)
+            launch(world);
+        world.step();
+    }
+
+    start = bench_now();
+    do {
+        for (int i = 0; i < 100; ++i, ++steps) {
+            int phase = int(steps % steps_per_flight);
+
+            for (int k = phase * flying / steps_per_flight; k < (phase + 1) * flying / steps_per_flight; ++k)
+                launch(world);
+
+            for (int k = 0; k < BENCH_TOUCHES; ++k)
+                checksum += world.entityAt(float(bench_random(int(world.width()))), float(bench_random(int(world.height()))));
+
+            checksum += world.step();
+        }
+        elapsed = bench_now() - start;
+    } while (elapsed < BENCH_MIN_TIME);
+
+    // Hit-tests of the same points by the grid and by the linear scan.
+    for (int i = 0; i < BENCH_HIT_TESTS; ++i) {
+        points.push_back(float(bench_random(int(world.width()))));
+        points.push_back(float(bench_random(int(world.height()))));
+    }
+
+    start = bench_now();
+    for (int i = 0; i < BENCH_HIT_TESTS; ++i)
+        checksum += world.entityAt(points[2 * i], points[2 * i + 1]);
+    grid_ns = (bench_now() - start) * 1e9 / BENCH_HIT_TESTS;
+
+    linear_tests = BENCH_HIT_TESTS / (count / 100 + 1);
+    start = bench_now();
+    for (int i = 0; i < linear_tests; ++i)
+        checksum -= linear_entity_at(world, points[2 * i], points[2 * i + 1]);
+    linear_ns = (bench_now() - start) * 1e9 / linear_tests;
+
+    for (int i = 0; i < linear_tests; ++i)
+        checksum += world.entityAt(points[2 * i], points[2 * i + 1]);
+
+    printf("entities=%d particles=%d ticks_per_s=%.0f us_per_tick=%.2f hit_grid_ns=%.1f hit_linear_ns=%.1f winner=%d checksum=%ld\n",
+           count, world.particleCount(), steps / elapsed, elapsed * 1e6 / steps,
+           grid_ns, linear_ns, world.winner(), checksum);
+}
+
+int main(int argc, char *argv[])
+{
+    static const int default_counts[] = { 100, 1000, 10000, 100000 };
+    int runs = (argc > 1) ? argc - 1 : int(sizeof(default_counts) / sizeof(default_counts[0]));
+
+    for (int i = 0; i < runs; ++i) {
+        int count = (argc > 1) ? atoi(argv[i + 1]) : default_counts[i];
+
+        if (count <= 0) {
+            fprintf(stderr, "Incorrect count of entities: %s\n", argv[i + 1]);
+            fprintf(stderr, "Usage: %s [entities count]...\n", argv[0]);
+            return 1;
+        }
+
+        run(count);
+    }
+
+    return 0;
+}
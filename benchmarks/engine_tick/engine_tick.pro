@@ -0,0 +1,14 @@
+TEMPLATE = app
+TARGET = engine_tick
+
+CONFIG += console
+CONFIG -= app_bundle qt
+
+INCLUDEPATH += ../../src
+
+SOURCES += \
+    engine_tick.cpp \
+    ../../src/GameWorld.cpp
+
+HEADERS += \
+    ../../src/GameWorld.h
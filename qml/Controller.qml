@@ -56,10 +56,13 @@ Canvas {
 
                 var startEntity = entityManager.getPointed(startPosition)
                 var endEntity = entityManager.getPointed(endPosition)
-                console.log(startEntity.idinsib + " " +endEntity.idinsib)
-                if (startEntity.idinsib !== endEntity.idinsib){
-                    var charge = entityManager.changeScore(startPosition,endPosition)
-                    entityManager.createParticleObjects(startEntity.x+80, startEntity.y+80, endEntity.x, endEntity.y,charge, startEntity.player)
+                if (startEntity !== -1 && endEntity !== -1
+                        && entityViews.itemAt(startEntity).idinsib !== entityViews.itemAt(endEntity).idinsib){
+                    var startCorner = entityManager.entityPosition(startEntity)
+                    var endCorner = entityManager.entityPosition(endEntity)
+                    var nextplayer = entityManager.entityPlayer(startEntity)
+                    var charge = entityManager.changeScore(startPosition)
+                    entityManager.createParticleObjects(startCorner.x+80, startCorner.y+80, endCorner.x, endCorner.y, charge, nextplayer)
                 }
 
             }
@@ -41,13 +41,4 @@ AnimatedImage {
         anchors {  centerIn: parent }
         font.bold: true
     }
-
-    Timer {
-        interval: 1000
-        onTriggered:{
-            virus.score += 1
-            scoreText.text =  virus.score.toString()
-        }
-        running: true; repeat: true
-    }
 }
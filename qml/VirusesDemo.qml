@@ -1,16 +1,18 @@
 import QtQuick 2.0
+import Game 1.0
 
 Item {
     id: item
     width: 640
     height: 480
 
-    EntityManager {
+    GameEngine {
         id: entityManager
-        scene: item
+        sceneWidth: item.width
+        sceneHeight: item.height
     Component.onCompleted: {
-        var maxW = width
-        var maxH = height
+        var maxW = item.width
+        var maxH = item.height
         var posX, posY, player, score
         var lastPosX = 0
         var lastPosY = 0
@@ -33,6 +35,26 @@ Item {
     }
     }
 
+    Repeater {
+        id: entityViews
+        model: entityManager.entities
+        delegate: Entity {
+            x: model.posX
+            y: model.posY
+            player: model.player
+            score: model.score
+        }
+    }
+
+    // Rows of the model are a pool: delegates are reused by next particles
+    Repeater {
+        model: entityManager.particles
+        delegate: Particle {
+            x: model.posX
+            y: model.posY
+            visible: model.active
+        }
+    }
 
     Controller {
         anchors.fill: parent
@@ -42,9 +64,10 @@ Item {
         endRadius: 50
         onHooked: {
             var entity = entityManager.getPointed(position)
-            if (entity !== null) {
-                var entityPosition = Qt.point(entity.x + entity.width / 2, entity.y + entity.height / 2)
-                var entityPlayer = entity.player
+            if (entity !== -1) {
+                var corner = entityManager.entityPosition(entity)
+                var entityPosition = Qt.point(corner.x + entityManager.entitySize / 2, corner.y + entityManager.entitySize / 2)
+                var entityPlayer = entityManager.entityPlayer(entity)
                 if (entityPlayer === 1) {
                     startPosition = entityPosition
                     endPosition = startPosition
@@ -55,9 +78,10 @@ Item {
         }
         onMoved: {
             var entity = entityManager.getPointed(position)
-            if (entity !== null) {
-                var entityPosition = Qt.point(entity.x + entity.width / 2, entity.y + entity.height / 2)
-                var entityPlayer = entity.player
+            if (entity !== -1) {
+                var corner = entityManager.entityPosition(entity)
+                var entityPosition = Qt.point(corner.x + entityManager.entitySize / 2, corner.y + entityManager.entitySize / 2)
+                var entityPlayer = entityManager.entityPlayer(entity)
                 if (entityPlayer !== 1) {
                     endPosition = entityPosition
                     status = 2
@@ -0,0 +1,5 @@
+TEMPLATE = subdirs
+SUBDIRS = \
+        sbcr_latency \
+        ssap_parse \
+        suite
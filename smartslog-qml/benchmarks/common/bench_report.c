@@ -0,0 +1,248 @@
+/**
+ * @file   bench_report.c
+ * @brief  Samples of measurements and JSON reports of benchmarks.
+ *
+ *
+ * @section LICENSE
+ *
+ * SmartSlog KP Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SmartSlog KP Library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SmartSlog KP Library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * Implementation of benchmark reports, see bench_report.h.
+ */
+
+#include "bench_report.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <time.h>
+
+
+/******************************************************************************/
+/****************************** Structures list *******************************/
+/// @cond INTERNAL_STRUCTURES
+
+struct bench_report_s {
+    FILE *file;
+    bool is_file;               /**< Report is written to a file, not to stdout. */
+    int config_count;
+    int results_count;
+};
+
+/// @endcond
+/******************************************************************************/
+
+
+
+/******************************* Definitions *********************************/
+/**************************** Static functions *******************************/
+static int compare_doubles(const void *a, const void *b);
+static void start_results(bench_report_t *report);
+/*****************************************************************************/
+
+
+
+/******************************************************************************/
+/****************************** Implementations ******************************/
+/**************************** External functions *****************************/
+
+double bench_now_us()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec * 1e6 + now.tv_nsec / 1e3;
+}
+
+
+void bench_samples_init(bench_samples_t *samples)
+{
+    samples->values = NULL;
+    samples->count = 0;
+    samples->capacity = 0;
+    samples->is_sorted = true;
+}
+
+
+int bench_samples_add(bench_samples_t *samples, double value_us)
+{
+    if (samples->count == samples->capacity) {
+        int capacity = samples->capacity * 2 + 64;
+        double *values = (double *) realloc(samples->values, capacity * sizeof(double));
+
+        if (values == NULL) {
+            return -1;
+        }
+
+        samples->values = values;
+        samples->capacity = capacity;
+    }
+
+    samples->values[samples->count++] = value_us;
+    samples->is_sorted = false;
+
+    return 0;
+}
+
+
+double bench_samples_percentile(bench_samples_t *samples, double p)
+{
+    if (samples->is_sorted == false) {
+        qsort(samples->values, samples->count, sizeof(double), compare_doubles);
+        samples->is_sorted = true;
+    }
+
+    int index = (int) (p * (samples->count - 1) + 0.5);
+
+    return samples->values[index];
+}
+
+
+void bench_samples_free(bench_samples_t *samples)
+{
+    free(samples->values);
+    bench_samples_init(samples);
+}
+
+
+bench_report_t *bench_report_open(const char *path)
+{
+    bench_report_t *report = (bench_report_t *) calloc(1, sizeof(bench_report_t));
+
+    if (report == NULL) {
+        return NULL;
+    }
+
+    report->is_file = (path != NULL);
+    report->file = (path != NULL) ? fopen(path, "w") : stdout;
+
+    if (report->file == NULL) {
+        fprintf(stderr, "Can't open %s\n", path);
+        free(report);
+        return NULL;
+    }
+
+    fprintf(report->file, "{\n  \"config\": {");
+
+    return report;
+}
+
+
+void bench_report_set_config(bench_report_t *report, const char *name, int value)
+{
+    // The config section is closed by the first result.
+    if (report->config_count < 0) {
+        return;
+    }
+
+    fprintf(report->file, "%s\n    \"%s\": %d", (report->config_count > 0) ? "," : "", name, value);
+    ++report->config_count;
+}
+
+
+void bench_report_add(bench_report_t *report, const char *group, const char *operation,
+                      bench_samples_t *samples, const char *items, double items_per_sample,
+                      const char *params_format, ...)
+{
+    char params[256];
+    va_list arguments;
+    double sum = 0;
+    int i = 0;
+
+    if (samples->count == 0) {
+        return;
+    }
+
+    va_start(arguments, params_format);
+    vsnprintf(params, sizeof(params), params_format, arguments);
+    va_end(arguments);
+
+    for (i = 0; i < samples->count; ++i) {
+        sum += samples->values[i];
+    }
+
+    double mean = sum / samples->count;
+    double ops_per_s = (mean > 0) ? 1e6 / mean : 0;
+    double p50 = bench_samples_percentile(samples, 0.5);
+    double p99 = bench_samples_percentile(samples, 0.99);
+    double max = samples->values[samples->count - 1];
+
+    start_results(report);
+
+    fprintf(report->file,
+            "%s\n    {\"group\": \"%s\", \"operation\": \"%s\", \"params\": {%s},"
+            " \"samples\": %d, \"p50_us\": %.2f, \"p99_us\": %.2f, \"max_us\": %.2f, \"mean_us\": %.2f,"
+            " \"ops_per_s\": %.1f, \"items\": \"%s\", \"items_per_s\": %.1f}",
+            (report->results_count > 0) ? "," : "", group, operation, params,
+            samples->count, p50, p99, max, mean, ops_per_s, items, ops_per_s * items_per_sample);
+    fflush(report->file);
+
+    ++report->results_count;
+
+    if (report->is_file == true) {
+        printf("%-8s %-18s %-32s p50_us=%-9.1f p99_us=%-9.1f max_us=%-9.1f %s_per_s=%.0f\n",
+               group, operation, params, p50, p99, max, items, ops_per_s * items_per_sample);
+        fflush(stdout);
+    }
+}
+
+
+int bench_report_close(bench_report_t *report)
+{
+    start_results(report);
+
+    fprintf(report->file, "\n  ]\n}\n");
+
+    int result = ferror(report->file) ? -1 : 0;
+
+    if (report->is_file == true && fclose(report->file) != 0) {
+        result = -1;
+    } else if (report->is_file == false) {
+        fflush(report->file);
+    }
+
+    free(report);
+
+    return result;
+}
+
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+/***************************** Static functions *******************************/
+
+static int compare_doubles(const void *a, const void *b)
+{
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+
+    return (x > y) - (x < y);
+}
+
+
+/** @brief Closes the config section before the first result. */
+static void start_results(bench_report_t *report)
+{
+    if (report->config_count >= 0) {
+        fprintf(report->file, "\n  },\n  \"results\": [");
+        report->config_count = -1;
+    }
+}
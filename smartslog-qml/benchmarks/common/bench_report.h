@@ -0,0 +1,151 @@
+/**
+ * @file   bench_report.h
+ * @brief  Samples of measurements and JSON reports of benchmarks.
+ *
+ *
+ * @section LICENSE
+ *
+ * SmartSlog KP Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SmartSlog KP Library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SmartSlog KP Library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * A benchmark collects times of an operation (samples) and adds them to
+ * the report as one result. The report is a JSON document, so runs can be
+ * compared by scripts:
+ *
+ * {
+ *   "config": {"iterations": 100, ...},
+ *   "results": [
+ *     {"group": "ssap", "operation": "insert", "params": {"triples": 10},
+ *      "samples": 100, "p50_us": 80.1, "p99_us": 130.0, "max_us": 150.2,
+ *      "mean_us": 85.3, "ops_per_s": 11723.3,
+ *      "items": "triples", "items_per_s": 117233.0},
+ *     ...
+ *   ]
+ * }
+ *
+ * Results are written as they are added. If the report is written to a file,
+ * results are also printed to stdout as lines of text.
+ */
+
+#ifndef _BENCH_REPORT_H
+#define _BENCH_REPORT_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Measured times of an operation, microseconds. */
+typedef struct bench_samples_s {
+    double *values;
+    int count;
+    int capacity;
+    bool is_sorted;
+} bench_samples_t;
+
+/** @brief Report that is being written. */
+typedef struct bench_report_s bench_report_t;
+
+
+/**
+ * @brief Gets monotonic time.
+ * @return time, microseconds.
+ */
+double bench_now_us();
+
+/**
+ * @brief Initializes empty samples.
+ * @param samples. Samples.
+ */
+void bench_samples_init(bench_samples_t *samples);
+
+/**
+ * @brief Adds a measured time.
+ * @param samples. Samples.
+ * @param value_us. Time, microseconds.
+ * @return 0 on success or -1 otherwise.
+ */
+int bench_samples_add(bench_samples_t *samples, double value_us);
+
+/**
+ * @brief Gets a percentile of samples (samples are sorted).
+ * @param samples. Samples, at least one.
+ * @param p. Percentile from 0 to 1 (0.5 - median).
+ * @return time, microseconds.
+ */
+double bench_samples_percentile(bench_samples_t *samples, double p);
+
+/**
+ * @brief Frees samples, they can be used again after #bench_samples_init.
+ * @param samples. Samples.
+ */
+void bench_samples_free(bench_samples_t *samples);
+
+/**
+ * @brief Starts a report.
+ * @param path. File of the report or NULL to write it to stdout.
+ * @return report on success or NULL otherwise.
+ */
+bench_report_t *bench_report_open(const char *path);
+
+/**
+ * @brief Adds a parameter of the run to the config section.
+ *
+ * All parameters must be added before the first result.
+ *
+ * @param report. Report.
+ * @param name. Name of the parameter.
+ * @param value. Value of the parameter.
+ */
+void bench_report_set_config(bench_report_t *report, const char *name, int value);
+
+/**
+ * @brief Adds a result with statistics of samples.
+ *
+ * Parameters of the result are a printf format of JSON members,
+ * for example "\"triples\": %d".
+ *
+ * @param report. Report.
+ * @param group. Group of benchmarks.
+ * @param operation. Measured operation.
+ * @param samples. Times of the operation, at least one.
+ * @param items. Name of items that are processed by one operation (triples, bytes...).
+ * @param items_per_sample. Count of items that are processed by one operation.
+ * @param params_format. Format of parameters of the result.
+ */
+void bench_report_add(bench_report_t *report, const char *group, const char *operation,
+                      bench_samples_t *samples, const char *items, double items_per_sample,
+                      const char *params_format, ...)
+#ifdef __GNUC__
+    __attribute__((format(printf, 7, 8)))
+#endif
+    ;
+
+/**
+ * @brief Finishes the report and frees it.
+ * @param report. Report.
+ * @return 0 on success or -1 otherwise (write error).
+ */
+int bench_report_close(bench_report_t *report);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BENCH_REPORT_H */
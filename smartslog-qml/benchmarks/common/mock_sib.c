@@ -0,0 +1,1931 @@
+/**
+ * @file   mock_sib.c
+ * @brief  In-process stand-in for the smart space (SIB) for benchmarks.
+ *
+ *
+ * @section LICENSE
+ *
+ * SmartSlog KP Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SmartSlog KP Library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SmartSlog KP Library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * Implementation of the mock SIB, see mock_sib.h.
+ */
+
+#include "mock_sib.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <time.h>
+
+#include <pthread.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+
+
+/******************************************************************************/
+/****************************** Structures list *******************************/
+/// @cond INTERNAL_STRUCTURES
+
+#define MOCK_SIB_END_TAG "</SSAP_message>"
+#define MOCK_SIB_ID_MAX_LEN 256
+#define MOCK_SIB_RECV_CHUNK 65536
+#define MOCK_SIB_EVENTS_MAX 64
+#define MOCK_SIB_STORE_INITIAL_CAPACITY 1024
+
+/** @brief Wildcard of triple templates (SS_RDF_SIB_ANY). */
+#define MOCK_SIB_ANY "http://www.nokia.com/NRC/M3/sib#any"
+
+/** @brief Elements of a triple that are wildcards. */
+#define MOCK_SIB_ANY_SUBJECT 0x1
+#define MOCK_SIB_ANY_PREDICATE 0x2
+#define MOCK_SIB_ANY_OBJECT 0x4
+
+/** @brief Types of subjects and objects. */
+typedef enum mock_sib_term_type_e {
+    MOCK_SIB_URI = 0,
+    MOCK_SIB_LITERAL,
+    MOCK_SIB_BNODE
+} mock_sib_term_type_t;
+
+/** @brief Triple of the smart space or a template, strings follow the structure. */
+typedef struct mock_sib_triple_s {
+    struct mock_sib_triple_s *next;         /**< Next triple in the bucket of the triple. */
+    struct mock_sib_triple_s *next_subject; /**< Next triple in the bucket of the subject. */
+    unsigned int hash;
+    unsigned int subject_hash;
+    unsigned int mark;                      /**< Number of the last request that found the triple. */
+    int any;                                /**< MOCK_SIB_ANY_* flags of a template. */
+    int subject_type;
+    int object_type;
+    char *subject;
+    char *predicate;
+    char *object;
+} mock_sib_triple_t;
+
+/** @brief Growable array of triples. */
+typedef struct mock_sib_triples_s {
+    mock_sib_triple_t **items;
+    int count;
+    int capacity;
+} mock_sib_triples_t;
+
+/** @brief Triples of the smart space, hashed by whole triples and by subjects. */
+typedef struct mock_sib_store_s {
+    mock_sib_triple_t **buckets;
+    mock_sib_triple_t **subject_buckets;
+    unsigned int capacity;                  /**< Count of buckets, power of 2. */
+    int count;
+    unsigned int mark;                      /**< Number of the current request. */
+} mock_sib_store_t;
+
+/** @brief Growable text of a message. */
+typedef struct mock_sib_buffer_s {
+    char *data;
+    int length;
+    int capacity;
+    bool is_failed;                         /**< Memory was not allocated, the text is incomplete. */
+} mock_sib_buffer_t;
+
+/** @brief Message that waits for the latency, the text follows the structure. */
+typedef struct mock_sib_output_s {
+    struct mock_sib_output_s *next;
+    int socket;
+    bool is_closing;                        /**< Close the connection after sending. */
+    struct timespec due;
+    int length;
+    char data[1];
+} mock_sib_output_t;
+
+/** @brief Client connection with received but not handled data. */
+typedef struct mock_sib_connection_s {
+    int socket;
+    char *buffer;
+    int size;
+    int capacity;
+} mock_sib_connection_t;
+
+/** @brief Subscription that was made by a client. */
+typedef struct mock_sib_subscription_s {
+    int socket;                             /**< Socket for indications, -1 if closed. */
+    char node_id[MOCK_SIB_ID_MAX_LEN];
+    char space_id[MOCK_SIB_ID_MAX_LEN];
+    int sequence;                           /**< Number of the next indication. */
+    mock_sib_triples_t templates;           /**< RDF-M3 templates, empty for SPARQL. */
+} mock_sib_subscription_t;
+
+struct mock_sib_s {
+    int listener;
+    int epoll;
+    int wakeup;
+    int timer;                              /**< Expires when the first delayed message is due. */
+    int port;
+    pthread_t thread;
+    bool is_running;
+
+    /** Connections by socket descriptor. */
+    mock_sib_connection_t **connections;
+    int connections_capacity;
+
+    /** Subscriptions by number (ID), guarded by mutex. */
+    mock_sib_subscription_t *subscriptions;
+    int subscriptions_count;
+    int subscriptions_capacity;
+
+    /** Triples of the smart space, guarded by mutex. */
+    mock_sib_store_t store;
+
+    /** Delayed messages in the order of sending, guarded by mutex. */
+    int latency_us;
+    mock_sib_output_t *output_head;
+    mock_sib_output_t *output_tail;
+
+    /** Guards subscriptions, the store and sending, indications are sent from other threads. */
+    pthread_mutex_t mutex;
+};
+
+/// @endcond
+/******************************************************************************/
+
+
+
+/******************************* Definitions *********************************/
+/**************************** Static functions *******************************/
+static void *mock_sib_process(void *data);
+static void mock_sib_accept(mock_sib_t *sib);
+static void mock_sib_receive(mock_sib_t *sib, mock_sib_connection_t *connection);
+static void mock_sib_close(mock_sib_t *sib, int socket);
+static void mock_sib_handle(mock_sib_t *sib, mock_sib_connection_t *connection, const char *message);
+static int mock_sib_subscribe(mock_sib_t *sib, int socket, const char *node_id, const char *space_id,
+                              const char *message, mock_sib_buffer_t *extra);
+static int mock_sib_query(mock_sib_t *sib, const char *message, mock_sib_buffer_t *extra);
+static int mock_sib_sparql_select(mock_sib_t *sib, const char *begin, const char *end, mock_sib_buffer_t *extra);
+static const char *mock_sib_sparql_token(const char *cursor, const char **token, int *length);
+static void mock_sib_notify(mock_sib_t *sib, mock_sib_triples_t *inserted, mock_sib_triples_t *removed);
+static void mock_sib_send_indication(mock_sib_t *sib, int number,
+                                     mock_sib_triples_t *new_triples, mock_sib_triples_t *obsolete_triples);
+static int mock_sib_output(mock_sib_t *sib, int socket, const char *message, int length, bool is_closing);
+static void mock_sib_flush_output(mock_sib_t *sib);
+static void mock_sib_arm_timer(mock_sib_t *sib);
+static int mock_sib_send(int socket, const char *message, int length);
+static bool mock_sib_get_tag(const char *message, const char *tag, char *value, int length);
+static bool mock_sib_get_parameter(const char *message, const char *name, char *value, int length);
+static bool mock_sib_get_parameter_range(const char *message, const char *name, const char **begin, const char **end);
+static int mock_sib_decode(const char *begin, const char *end, char *text);
+static unsigned int mock_sib_hash(const char *text, unsigned int hash);
+static int mock_sib_get_type(const char *tag, const char *tag_end);
+
+static mock_sib_triple_t *mock_sib_new_triple(const char *subject, int subject_length, int subject_type,
+                                              const char *predicate, int predicate_length,
+                                              const char *object, int object_length, int object_type,
+                                              bool is_encoded);
+static int mock_sib_parse_triples(const char *begin, const char *end, mock_sib_triples_t *triples);
+static bool mock_sib_matches(const mock_sib_triple_t *triple_template, const mock_sib_triple_t *triple);
+static int mock_sib_triples_add(mock_sib_triples_t *triples, mock_sib_triple_t *triple);
+static void mock_sib_triples_free(mock_sib_triples_t *triples, bool with_triples);
+
+static bool mock_sib_store_init(mock_sib_store_t *store);
+static void mock_sib_store_free(mock_sib_store_t *store);
+static void mock_sib_store_grow(mock_sib_store_t *store);
+static bool mock_sib_store_add(mock_sib_store_t *store, mock_sib_triple_t *triple);
+static void mock_sib_store_unlink(mock_sib_store_t *store, mock_sib_triple_t *triple);
+static int mock_sib_store_query(mock_sib_store_t *store, const mock_sib_triple_t *triple_template,
+                                mock_sib_triples_t *found);
+
+static void mock_sib_buffer_append(mock_sib_buffer_t *buffer, const char *data, int length);
+static void mock_sib_buffer_format(mock_sib_buffer_t *buffer, const char *format, ...);
+static void mock_sib_buffer_escape(mock_sib_buffer_t *buffer, const char *text);
+static void mock_sib_buffer_triples(mock_sib_buffer_t *buffer, mock_sib_triples_t *triples);
+/*****************************************************************************/
+
+
+
+/******************************************************************************/
+/****************************** Implementations ******************************/
+/**************************** External functions *****************************/
+
+mock_sib_t *mock_sib_start(int port)
+{
+    mock_sib_t *sib = (mock_sib_t *) calloc(1, sizeof(mock_sib_t));
+
+    if (sib == NULL) {
+        return NULL;
+    }
+
+    pthread_mutex_init(&sib->mutex, NULL);
+
+    sib->listener = socket(AF_INET, SOCK_STREAM, 0);
+    sib->epoll = epoll_create1(EPOLL_CLOEXEC);
+    sib->wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    sib->timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int reuse = 1;
+    setsockopt(sib->listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    socklen_t address_len = sizeof(address);
+
+    if (sib->listener < 0 || sib->epoll < 0 || sib->wakeup < 0 || sib->timer < 0
+            || mock_sib_store_init(&sib->store) == false
+            || bind(sib->listener, (struct sockaddr *) &address, sizeof(address)) != 0
+            || listen(sib->listener, SOMAXCONN) != 0
+            || getsockname(sib->listener, (struct sockaddr *) &address, &address_len) != 0) {
+        fprintf(stderr, "mock SIB: can't listen: %s\n", strerror(errno));
+        mock_sib_stop(sib);
+        return NULL;
+    }
+
+    sib->port = ntohs(address.sin_port);
+
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = sib->listener;
+    epoll_ctl(sib->epoll, EPOLL_CTL_ADD, sib->listener, &event);
+
+    event.data.fd = sib->wakeup;
+    epoll_ctl(sib->epoll, EPOLL_CTL_ADD, sib->wakeup, &event);
+
+    event.data.fd = sib->timer;
+    epoll_ctl(sib->epoll, EPOLL_CTL_ADD, sib->timer, &event);
+
+    if (pthread_create(&sib->thread, NULL, mock_sib_process, sib) != 0) {
+        mock_sib_stop(sib);
+        return NULL;
+    }
+
+    sib->is_running = true;
+
+    return sib;
+}
+
+
+void mock_sib_stop(mock_sib_t *sib)
+{
+    if (sib == NULL) {
+        return;
+    }
+
+    if (sib->is_running == true) {
+        uint64_t value = 1;
+
+        if (write(sib->wakeup, &value, sizeof(value)) == sizeof(value)) {
+            pthread_join(sib->thread, NULL);
+        }
+    }
+
+    int i = 0;
+    for (i = 0; i < sib->connections_capacity; ++i) {
+        if (sib->connections[i] != NULL) {
+            mock_sib_close(sib, i);
+        }
+    }
+
+    if (sib->listener >= 0) {
+        close(sib->listener);
+    }
+
+    if (sib->epoll >= 0) {
+        close(sib->epoll);
+    }
+
+    if (sib->wakeup >= 0) {
+        close(sib->wakeup);
+    }
+
+    if (sib->timer >= 0) {
+        close(sib->timer);
+    }
+
+    while (sib->output_head != NULL) {
+        mock_sib_output_t *output = sib->output_head;
+        sib->output_head = output->next;
+        free(output);
+    }
+
+    for (i = 0; i < sib->subscriptions_count; ++i) {
+        mock_sib_triples_free(&sib->subscriptions[i].templates, true);
+    }
+
+    mock_sib_store_free(&sib->store);
+
+    pthread_mutex_destroy(&sib->mutex);
+
+    free(sib->connections);
+    free(sib->subscriptions);
+    free(sib);
+}
+
+
+int mock_sib_port(mock_sib_t *sib)
+{
+    return sib->port;
+}
+
+
+int mock_sib_subscriptions_count(mock_sib_t *sib)
+{
+    pthread_mutex_lock(&sib->mutex);
+    int count = sib->subscriptions_count;
+    pthread_mutex_unlock(&sib->mutex);
+
+    return count;
+}
+
+
+int mock_sib_indicate(mock_sib_t *sib, int subscription,
+                      const char *subject, const char *predicate, const char *object)
+{
+    mock_sib_triple_t *triple = mock_sib_new_triple(subject, (int) strlen(subject), MOCK_SIB_URI,
+                                                    predicate, (int) strlen(predicate),
+                                                    object, (int) strlen(object), MOCK_SIB_LITERAL, false);
+    mock_sib_triples_t new_triples = {&triple, 1, 1};
+    mock_sib_triples_t obsolete_triples = {NULL, 0, 0};
+    int result = -1;
+
+    if (triple == NULL) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&sib->mutex);
+
+    if (subscription >= 0 && subscription < sib->subscriptions_count
+            && sib->subscriptions[subscription].socket >= 0) {
+        mock_sib_send_indication(sib, subscription, &new_triples, &obsolete_triples);
+        result = 0;
+    }
+
+    pthread_mutex_unlock(&sib->mutex);
+
+    free(triple);
+
+    return result;
+}
+
+
+void mock_sib_set_latency(mock_sib_t *sib, int latency_us)
+{
+    pthread_mutex_lock(&sib->mutex);
+    sib->latency_us = (latency_us > 0) ? latency_us : 0;
+    pthread_mutex_unlock(&sib->mutex);
+}
+
+
+int mock_sib_generate(mock_sib_t *sib, const char *subject_prefix, const char *predicate,
+                      int count, int payload_size)
+{
+    static const char pattern[] = "payload ";
+    int prefix_length = (int) strlen(subject_prefix);
+    char *subject = (char *) malloc(prefix_length + 16);
+    char *object = (char *) malloc(payload_size + 1);
+    int result = 0;
+    int i = 0;
+
+    if (subject == NULL || object == NULL) {
+        free(subject);
+        free(object);
+        return -1;
+    }
+
+    for (i = 0; i < payload_size; ++i) {
+        object[i] = pattern[i % (sizeof(pattern) - 1)];
+    }
+
+    object[payload_size] = '\0';
+
+    pthread_mutex_lock(&sib->mutex);
+
+    for (i = 0; i < count; ++i) {
+        int subject_length = snprintf(subject, prefix_length + 16, "%s%d", subject_prefix, i);
+        mock_sib_triple_t *triple = mock_sib_new_triple(subject, subject_length, MOCK_SIB_URI,
+                                                        predicate, (int) strlen(predicate),
+                                                        object, payload_size, MOCK_SIB_LITERAL, false);
+
+        if (triple == NULL) {
+            result = -1;
+            break;
+        }
+
+        if (mock_sib_store_add(&sib->store, triple) == false) {
+            free(triple);
+        }
+    }
+
+    pthread_mutex_unlock(&sib->mutex);
+
+    free(subject);
+    free(object);
+
+    return result;
+}
+
+
+int mock_sib_triples_count(mock_sib_t *sib)
+{
+    pthread_mutex_lock(&sib->mutex);
+    int count = sib->store.count;
+    pthread_mutex_unlock(&sib->mutex);
+
+    return count;
+}
+
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+/***************************** Static functions *******************************/
+
+/** @brief Serves connections until the SIB is stopped. */
+static void *mock_sib_process(void *data)
+{
+    mock_sib_t *sib = (mock_sib_t *) data;
+    struct epoll_event events[MOCK_SIB_EVENTS_MAX];
+
+    while (true) {
+        int count = epoll_wait(sib->epoll, events, MOCK_SIB_EVENTS_MAX, -1);
+
+        if (count < 0 && errno != EINTR) {
+            break;
+        }
+
+        int i = 0;
+        for (i = 0; i < count; ++i) {
+            int socket = events[i].data.fd;
+
+            if (socket == sib->wakeup) {
+                return NULL;
+            } else if (socket == sib->timer) {
+                mock_sib_flush_output(sib);
+            } else if (socket == sib->listener) {
+                mock_sib_accept(sib);
+            } else if (socket < sib->connections_capacity && sib->connections[socket] != NULL) {
+                mock_sib_receive(sib, sib->connections[socket]);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+
+static void mock_sib_accept(mock_sib_t *sib)
+{
+    int socket = accept(sib->listener, NULL, NULL);
+
+    if (socket < 0) {
+        return;
+    }
+
+    int no_delay = 1;
+    setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+
+    if (socket >= sib->connections_capacity) {
+        int capacity = (socket + 1) * 2;
+        mock_sib_connection_t **connections = (mock_sib_connection_t **)
+                realloc(sib->connections, capacity * sizeof(mock_sib_connection_t *));
+
+        if (connections == NULL) {
+            close(socket);
+            return;
+        }
+
+        memset(connections + sib->connections_capacity, 0,
+               (capacity - sib->connections_capacity) * sizeof(mock_sib_connection_t *));
+        sib->connections = connections;
+        sib->connections_capacity = capacity;
+    }
+
+    mock_sib_connection_t *connection = (mock_sib_connection_t *) calloc(1, sizeof(mock_sib_connection_t));
+
+    if (connection == NULL) {
+        close(socket);
+        return;
+    }
+
+    connection->socket = socket;
+    sib->connections[socket] = connection;
+
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = socket;
+    epoll_ctl(sib->epoll, EPOLL_CTL_ADD, socket, &event);
+}
+
+
+static void mock_sib_receive(mock_sib_t *sib, mock_sib_connection_t *connection)
+{
+    if (connection->capacity - connection->size < MOCK_SIB_RECV_CHUNK + 1) {
+        int capacity = connection->capacity * 2 + MOCK_SIB_RECV_CHUNK + 1;
+        char *buffer = (char *) realloc(connection->buffer, capacity);
+
+        if (buffer == NULL) {
+            mock_sib_close(sib, connection->socket);
+            return;
+        }
+
+        connection->buffer = buffer;
+        connection->capacity = capacity;
+    }
+
+    // The end tag can't be in the data that was searched already
+    // (except the last bytes), so big messages are searched once.
+    int searched = connection->size - (int) strlen(MOCK_SIB_END_TAG) + 1;
+
+    if (searched < 0) {
+        searched = 0;
+    }
+
+    int bytes = recv(connection->socket, connection->buffer + connection->size, MOCK_SIB_RECV_CHUNK, 0);
+
+    if (bytes <= 0) {
+        mock_sib_close(sib, connection->socket);
+        return;
+    }
+
+    connection->size += bytes;
+    connection->buffer[connection->size] = '\0';
+
+    // Handle all complete messages, keep the rest.
+    char *begin = connection->buffer;
+    char *search = connection->buffer + searched;
+    char *end = NULL;
+
+    while ((end = strstr(search, MOCK_SIB_END_TAG)) != NULL) {
+        end += strlen(MOCK_SIB_END_TAG);
+
+        char saved = *end;
+        *end = '\0';
+        mock_sib_handle(sib, connection, begin);
+        *end = saved;
+
+        begin = end;
+        search = end;
+    }
+
+    connection->size -= (int) (begin - connection->buffer);
+    memmove(connection->buffer, begin, connection->size + 1);
+}
+
+
+static void mock_sib_close(mock_sib_t *sib, int socket)
+{
+    mock_sib_connection_t *connection = sib->connections[socket];
+
+    pthread_mutex_lock(&sib->mutex);
+
+    int i = 0;
+    for (i = 0; i < sib->subscriptions_count; ++i) {
+        if (sib->subscriptions[i].socket == socket) {
+            sib->subscriptions[i].socket = -1;
+            mock_sib_triples_free(&sib->subscriptions[i].templates, true);
+        }
+    }
+
+    // Delayed messages must not go to a new connection with the same descriptor.
+    mock_sib_output_t **link = &sib->output_head;
+    bool is_head_removed = false;
+
+    sib->output_tail = NULL;
+
+    while (*link != NULL) {
+        mock_sib_output_t *output = *link;
+
+        if (output->socket == socket) {
+            is_head_removed = is_head_removed || (link == &sib->output_head);
+            *link = output->next;
+            free(output);
+        } else {
+            sib->output_tail = output;
+            link = &output->next;
+        }
+    }
+
+    if (is_head_removed == true) {
+        mock_sib_arm_timer(sib);
+    }
+
+    pthread_mutex_unlock(&sib->mutex);
+
+    epoll_ctl(sib->epoll, EPOLL_CTL_DEL, socket, NULL);
+    close(socket);
+
+    sib->connections[socket] = NULL;
+    free(connection->buffer);
+    free(connection);
+}
+
+
+/** @brief Handles one SSAP request and sends the confirmation. */
+static void mock_sib_handle(mock_sib_t *sib, mock_sib_connection_t *connection, const char *message)
+{
+    char type[64];
+    char transaction_id[64];
+    char node_id[MOCK_SIB_ID_MAX_LEN];
+    char space_id[MOCK_SIB_ID_MAX_LEN];
+    const char *status = "m3:Success";
+    const char *begin = NULL;
+    const char *end = NULL;
+    mock_sib_buffer_t extra = {NULL, 0, 0, false};
+    mock_sib_buffer_t reply = {NULL, 0, 0, false};
+    mock_sib_triples_t graph = {NULL, 0, 0};
+    mock_sib_triples_t templates = {NULL, 0, 0};
+    mock_sib_triples_t inserted = {NULL, 0, 0};
+    mock_sib_triples_t removed = {NULL, 0, 0};
+    int reply_socket = connection->socket;
+    int close_socket = -1;
+    int result = 0;
+    int i = 0;
+
+    if (mock_sib_get_tag(message, "transaction_type", type, sizeof(type)) == false
+            || mock_sib_get_tag(message, "transaction_id", transaction_id, sizeof(transaction_id)) == false
+            || mock_sib_get_tag(message, "node_id", node_id, sizeof(node_id)) == false
+            || mock_sib_get_tag(message, "space_id", space_id, sizeof(space_id)) == false) {
+        fprintf(stderr, "mock SIB: incorrect message: %s\n", message);
+        return;
+    }
+
+    // Graphs of requests are parsed before the lock.
+    if (strcmp(type, "INSERT") == 0 || strcmp(type, "UPDATE") == 0) {
+        if (mock_sib_get_parameter_range(message, "insert_graph", &begin, &end) == false
+                || mock_sib_parse_triples(begin, end, &graph) != 0) {
+            result = -1;
+        }
+    }
+
+    if (strcmp(type, "REMOVE") == 0 || strcmp(type, "UPDATE") == 0) {
+        if (mock_sib_get_parameter_range(message, "remove_graph", &begin, &end) == false
+                || mock_sib_parse_triples(begin, end, &templates) != 0) {
+            result = -1;
+        }
+    }
+
+    pthread_mutex_lock(&sib->mutex);
+
+    if (result != 0) {
+        // Incorrect graph.
+    } else if (strcmp(type, "SUBSCRIBE") == 0) {
+        result = mock_sib_subscribe(sib, connection->socket, node_id, space_id, message, &extra);
+    } else if (strcmp(type, "UNSUBSCRIBE") == 0) {
+        // Request comes by the node socket, confirmation is sent
+        // by the subscription socket that is closed then.
+        char id[64];
+        int number = -1;
+
+        if (mock_sib_get_parameter(message, "subscription_id", id, sizeof(id)) == true) {
+            number = atoi(id);
+        }
+
+        if (number >= 0 && number < sib->subscriptions_count
+                && sib->subscriptions[number].socket >= 0) {
+            reply_socket = sib->subscriptions[number].socket;
+            close_socket = reply_socket;
+            mock_sib_buffer_format(&extra, "<parameter name=\"subscription_id\">%d</parameter>", number);
+        } else {
+            result = -1;
+        }
+    } else if (strcmp(type, "QUERY") == 0) {
+        result = mock_sib_query(sib, message, &extra);
+    } else if (strcmp(type, "REMOVE") == 0 || strcmp(type, "UPDATE") == 0 || strcmp(type, "INSERT") == 0) {
+        // Update removes triples and inserts new ones then.
+        ++sib->store.mark;
+
+        for (i = 0; i < templates.count && result == 0; ++i) {
+            result = mock_sib_store_query(&sib->store, templates.items[i], &removed);
+        }
+
+        for (i = 0; i < removed.count; ++i) {
+            mock_sib_store_unlink(&sib->store, removed.items[i]);
+        }
+
+        for (i = 0; i < graph.count && result == 0; ++i) {
+            if (mock_sib_store_add(&sib->store, graph.items[i]) == true) {
+                result = mock_sib_triples_add(&inserted, graph.items[i]);
+                graph.items[i] = NULL;
+            }
+        }
+    } else if (strcmp(type, "JOIN") != 0 && strcmp(type, "LEAVE") != 0) {
+        result = -1;
+    }
+
+    if (result != 0 || extra.is_failed == true) {
+        status = "m3:Error";
+        extra.length = 0;
+        close_socket = -1;
+    }
+
+    mock_sib_buffer_format(&reply,
+                           "<SSAP_message><transaction_type>%s</transaction_type>"
+                           "<message_type>CONFIRM</message_type>"
+                           "<transaction_id>%s</transaction_id>"
+                           "<node_id>%s</node_id><space_id>%s</space_id>"
+                           "<parameter name=\"status\">%s</parameter>",
+                           type, transaction_id, node_id, space_id, status);
+    mock_sib_buffer_append(&reply, extra.data, extra.length);
+    mock_sib_buffer_append(&reply, MOCK_SIB_END_TAG, (int) strlen(MOCK_SIB_END_TAG));
+
+    if (reply.is_failed == false) {
+        mock_sib_output(sib, reply_socket, reply.data, reply.length, close_socket >= 0);
+    }
+
+    // Subscribers get indications after the confirmation.
+    if (inserted.count > 0 || removed.count > 0) {
+        mock_sib_notify(sib, &inserted, &removed);
+    }
+
+    // Delayed confirmation of UNSUBSCRIBE closes the socket itself.
+    if (sib->latency_us > 0) {
+        close_socket = -1;
+    }
+
+    pthread_mutex_unlock(&sib->mutex);
+
+    if (close_socket >= 0 && close_socket < sib->connections_capacity
+            && sib->connections[close_socket] != NULL) {
+        mock_sib_close(sib, close_socket);
+    }
+
+    // Inserted triples are stored, removed ones are unlinked from the store.
+    mock_sib_triples_free(&graph, true);
+    mock_sib_triples_free(&templates, true);
+    mock_sib_triples_free(&inserted, false);
+    mock_sib_triples_free(&removed, true);
+
+    free(extra.data);
+    free(reply.data);
+}
+
+
+/**
+ * @brief Makes a new subscription, called with the locked mutex.
+ * @return 0 on success or -1 otherwise.
+ */
+static int mock_sib_subscribe(mock_sib_t *sib, int socket, const char *node_id, const char *space_id,
+                              const char *message, mock_sib_buffer_t *extra)
+{
+    mock_sib_triples_t found = {NULL, 0, 0};
+    const char *begin = NULL;
+    const char *end = NULL;
+    char query_type[64];
+    int result = 0;
+    int i = 0;
+
+    if (sib->subscriptions_count == sib->subscriptions_capacity) {
+        int capacity = sib->subscriptions_capacity * 2 + 16;
+        mock_sib_subscription_t *subscriptions = (mock_sib_subscription_t *)
+                realloc(sib->subscriptions, capacity * sizeof(mock_sib_subscription_t));
+
+        if (subscriptions == NULL) {
+            return -1;
+        }
+
+        sib->subscriptions = subscriptions;
+        sib->subscriptions_capacity = capacity;
+    }
+
+    mock_sib_subscription_t *sbcr = &sib->subscriptions[sib->subscriptions_count];
+    memset(sbcr, 0, sizeof(mock_sib_subscription_t));
+
+    // SPARQL subscriptions get no results and only indications by mock_sib_indicate().
+    if (mock_sib_get_parameter(message, "type", query_type, sizeof(query_type)) == true
+            && strcmp(query_type, "RDF-M3") == 0) {
+        if (mock_sib_get_parameter_range(message, "query", &begin, &end) == false
+                || mock_sib_parse_triples(begin, end, &sbcr->templates) != 0) {
+            mock_sib_triples_free(&sbcr->templates, true);
+            return -1;
+        }
+
+        ++sib->store.mark;
+
+        for (i = 0; i < sbcr->templates.count && result == 0; ++i) {
+            result = mock_sib_store_query(&sib->store, sbcr->templates.items[i], &found);
+        }
+    }
+
+    if (result != 0) {
+        mock_sib_triples_free(&sbcr->templates, true);
+        mock_sib_triples_free(&found, false);
+        return -1;
+    }
+
+    sbcr->socket = socket;
+    sbcr->sequence = 0;
+    snprintf(sbcr->node_id, sizeof(sbcr->node_id), "%s", node_id);
+    snprintf(sbcr->space_id, sizeof(sbcr->space_id), "%s", space_id);
+
+    mock_sib_buffer_format(extra,
+                           "<parameter name=\"subscription_id\">%d</parameter>"
+                           "<parameter name=\"results\">",
+                           sib->subscriptions_count);
+    mock_sib_buffer_triples(extra, &found);
+    mock_sib_buffer_format(extra, "</parameter>");
+
+    ++sib->subscriptions_count;
+
+    mock_sib_triples_free(&found, false);
+
+    return 0;
+}
+
+
+/**
+ * @brief Handles QUERY with RDF-M3 templates or SPARQL SELECT, called with the locked mutex.
+ * @return 0 on success or -1 otherwise.
+ */
+static int mock_sib_query(mock_sib_t *sib, const char *message, mock_sib_buffer_t *extra)
+{
+    mock_sib_triples_t templates = {NULL, 0, 0};
+    mock_sib_triples_t found = {NULL, 0, 0};
+    const char *begin = NULL;
+    const char *end = NULL;
+    char query_type[64];
+    int result = 0;
+    int i = 0;
+
+    if (mock_sib_get_parameter(message, "type", query_type, sizeof(query_type)) == false
+            || mock_sib_get_parameter_range(message, "query", &begin, &end) == false) {
+        return -1;
+    }
+
+    if (strcmp(query_type, "sparql") == 0) {
+        return mock_sib_sparql_select(sib, begin, end, extra);
+    }
+
+    if (strcmp(query_type, "RDF-M3") != 0 || mock_sib_parse_triples(begin, end, &templates) != 0) {
+        mock_sib_triples_free(&templates, true);
+        return -1;
+    }
+
+    ++sib->store.mark;
+
+    for (i = 0; i < templates.count && result == 0; ++i) {
+        result = mock_sib_store_query(&sib->store, templates.items[i], &found);
+    }
+
+    if (result == 0) {
+        mock_sib_buffer_format(extra, "<parameter name=\"results\">");
+        mock_sib_buffer_triples(extra, &found);
+        mock_sib_buffer_format(extra, "</parameter>");
+    }
+
+    mock_sib_triples_free(&templates, true);
+    mock_sib_triples_free(&found, false);
+
+    return result;
+}
+
+
+/** @brief Reads the next token of a SPARQL query: IRI, literal, variable, word or punctuation. */
+static const char *mock_sib_sparql_token(const char *cursor, const char **token, int *length)
+{
+    while (*cursor == ' ' || *cursor == '\t' || *cursor == '\r' || *cursor == '\n') {
+        ++cursor;
+    }
+
+    const char *begin = cursor;
+
+    if (*cursor == '<' || *cursor == '"') {
+        const char *end = strchr(cursor + 1, (*cursor == '<') ? '>' : '"');
+
+        cursor = (end != NULL) ? end + 1 : cursor + strlen(cursor);
+    } else if (*cursor == '?' || *cursor == '$' || (*cursor >= 'A' && *cursor <= 'Z') || (*cursor >= 'a' && *cursor <= 'z')) {
+        ++cursor;
+
+        while (*cursor == '_' || (*cursor >= '0' && *cursor <= '9')
+               || (*cursor >= 'A' && *cursor <= 'Z') || (*cursor >= 'a' && *cursor <= 'z')) {
+            ++cursor;
+        }
+    } else if (*cursor != '\0') {
+        ++cursor;
+    }
+
+    *token = begin;
+    *length = (int) (cursor - begin);
+
+    return cursor;
+}
+
+
+/**
+ * @brief Handles SPARQL SELECT with one triple pattern, called with the locked mutex.
+ *
+ * Supported form: SELECT [DISTINCT] (?var... | *) [WHERE] { term term term [.] },
+ * where terms are variables, <IRI> or "literal".
+ *
+ * @return 0 on success or -1 otherwise (the query is not supported).
+ */
+static int mock_sib_sparql_select(mock_sib_t *sib, const char *begin, const char *end, mock_sib_buffer_t *extra)
+{
+    mock_sib_triples_t found = {NULL, 0, 0};
+    mock_sib_triple_t *triple_template = NULL;
+    const char *terms[3];
+    int terms_length[3];
+    const char *variables[3];
+    int variables_length[3];
+    int variables_count = 0;
+    bool is_all = false;
+    const char *token = NULL;
+    int length = 0;
+    int result = -1;
+    int i = 0;
+    int k = 0;
+
+    // The query is escaped in the message.
+    char *query = (char *) malloc(end - begin + 1);
+
+    if (query == NULL) {
+        return -1;
+    }
+
+    mock_sib_decode(begin, end, query);
+
+    const char *cursor = mock_sib_sparql_token(query, &token, &length);
+
+    if (length != 6 || strncasecmp(token, "SELECT", 6) != 0) {
+        goto done;
+    }
+
+    cursor = mock_sib_sparql_token(cursor, &token, &length);
+
+    if (length == 8 && strncasecmp(token, "DISTINCT", 8) == 0) {
+        cursor = mock_sib_sparql_token(cursor, &token, &length);
+    }
+
+    if (length == 1 && *token == '*') {
+        is_all = true;
+        cursor = mock_sib_sparql_token(cursor, &token, &length);
+    } else {
+        while (length > 1 && (*token == '?' || *token == '$')) {
+            if (variables_count == 3) {
+                goto done;
+            }
+
+            variables[variables_count] = token + 1;
+            variables_length[variables_count] = length - 1;
+            ++variables_count;
+
+            cursor = mock_sib_sparql_token(cursor, &token, &length);
+        }
+    }
+
+    if (length == 5 && strncasecmp(token, "WHERE", 5) == 0) {
+        cursor = mock_sib_sparql_token(cursor, &token, &length);
+    }
+
+    if (length != 1 || *token != '{' || (is_all == false && variables_count == 0)) {
+        goto done;
+    }
+
+    for (i = 0; i < 3; ++i) {
+        cursor = mock_sib_sparql_token(cursor, &terms[i], &terms_length[i]);
+
+        bool is_variable = (terms_length[i] > 1 && (*terms[i] == '?' || *terms[i] == '$'));
+        bool is_iri = (terms_length[i] > 1 && *terms[i] == '<' && terms[i][terms_length[i] - 1] == '>');
+        bool is_literal = (i == 2 && terms_length[i] > 1 && *terms[i] == '"' && terms[i][terms_length[i] - 1] == '"');
+
+        if (is_variable == false && is_iri == false && is_literal == false) {
+            goto done;
+        }
+
+        if (is_variable == true && is_all == true) {
+            for (k = 0; k < variables_count; ++k) {
+                if (variables_length[k] == terms_length[i] - 1
+                        && strncmp(variables[k], terms[i] + 1, variables_length[k]) == 0) {
+                    break;
+                }
+            }
+
+            if (k == variables_count) {
+                variables[variables_count] = terms[i] + 1;
+                variables_length[variables_count] = terms_length[i] - 1;
+                ++variables_count;
+            }
+        }
+    }
+
+    cursor = mock_sib_sparql_token(cursor, &token, &length);
+
+    if (length == 1 && *token == '.') {
+        cursor = mock_sib_sparql_token(cursor, &token, &length);
+    }
+
+    if (length != 1 || *token != '}') {
+        goto done;
+    }
+
+    // Position of each selected variable in the pattern.
+    int positions[3];
+
+    for (k = 0; k < variables_count; ++k) {
+        positions[k] = -1;
+
+        for (i = 2; i >= 0; --i) {
+            if ((*terms[i] == '?' || *terms[i] == '$') && terms_length[i] - 1 == variables_length[k]
+                    && strncmp(terms[i] + 1, variables[k], variables_length[k]) == 0) {
+                positions[k] = i;
+            }
+        }
+
+        if (positions[k] < 0) {
+            goto done;
+        }
+    }
+
+    // Variables of the pattern are wildcards of the template.
+    const char *values[3];
+    int values_length[3];
+
+    for (i = 0; i < 3; ++i) {
+        bool is_variable = (*terms[i] == '?' || *terms[i] == '$');
+
+        values[i] = is_variable ? MOCK_SIB_ANY : terms[i] + 1;
+        values_length[i] = is_variable ? (int) strlen(MOCK_SIB_ANY) : terms_length[i] - 2;
+    }
+
+    triple_template = mock_sib_new_triple(values[0], values_length[0], MOCK_SIB_URI,
+                                          values[1], values_length[1],
+                                          values[2], values_length[2],
+                                          (*terms[2] == '"') ? MOCK_SIB_LITERAL : MOCK_SIB_URI, false);
+
+    if (triple_template == NULL) {
+        goto done;
+    }
+
+    ++sib->store.mark;
+
+    if (mock_sib_store_query(&sib->store, triple_template, &found) != 0) {
+        goto done;
+    }
+
+    mock_sib_buffer_format(extra,
+                           "<parameter name=\"results\">"
+                           "<sparql xmlns=\"http://www.w3.org/2005/sparql-results#\"><head>");
+
+    for (k = 0; k < variables_count; ++k) {
+        mock_sib_buffer_format(extra, "<variable name=\"%.*s\"/>", variables_length[k], variables[k]);
+    }
+
+    mock_sib_buffer_format(extra, "</head><results>");
+
+    for (i = 0; i < found.count; ++i) {
+        mock_sib_triple_t *triple = found.items[i];
+        const char *elements[3] = {triple->subject, triple->predicate, triple->object};
+        int types[3] = {triple->subject_type, MOCK_SIB_URI, triple->object_type};
+        bool is_consistent = true;
+        int j = 0;
+
+        // The same variable in several positions must have the same value.
+        for (k = 0; k < 3; ++k) {
+            for (j = k + 1; j < 3; ++j) {
+                if ((*terms[k] == '?' || *terms[k] == '$') && terms_length[k] == terms_length[j]
+                        && strncmp(terms[k] + 1, terms[j] + 1, terms_length[k] - 1) == 0
+                        && strcmp(elements[k], elements[j]) != 0) {
+                    is_consistent = false;
+                }
+            }
+        }
+
+        if (is_consistent == false) {
+            continue;
+        }
+
+        mock_sib_buffer_format(extra, "<result>");
+
+        for (k = 0; k < variables_count; ++k) {
+            const char *tag = (types[positions[k]] == MOCK_SIB_LITERAL) ? "literal"
+                    : (types[positions[k]] == MOCK_SIB_BNODE) ? "bnode" : "uri";
+
+            mock_sib_buffer_format(extra, "<binding name=\"%.*s\"><%s>", variables_length[k], variables[k], tag);
+            mock_sib_buffer_escape(extra, elements[positions[k]]);
+            mock_sib_buffer_format(extra, "</%s></binding>", tag);
+        }
+
+        mock_sib_buffer_format(extra, "</result>");
+    }
+
+    mock_sib_buffer_format(extra, "</results></sparql></parameter>");
+
+    result = 0;
+
+done:
+    mock_sib_triples_free(&found, false);
+    free(triple_template);
+    free(query);
+
+    return result;
+}
+
+
+/** @brief Sends indications to subscriptions with matching templates, called with the locked mutex. */
+static void mock_sib_notify(mock_sib_t *sib, mock_sib_triples_t *inserted, mock_sib_triples_t *removed)
+{
+    mock_sib_triples_t new_triples = {NULL, 0, 0};
+    mock_sib_triples_t obsolete_triples = {NULL, 0, 0};
+    int number = 0;
+    int i = 0;
+    int k = 0;
+
+    for (number = 0; number < sib->subscriptions_count; ++number) {
+        mock_sib_subscription_t *sbcr = &sib->subscriptions[number];
+
+        if (sbcr->socket < 0 || sbcr->templates.count == 0) {
+            continue;
+        }
+
+        new_triples.count = 0;
+        obsolete_triples.count = 0;
+
+        for (i = 0; i < inserted->count; ++i) {
+            for (k = 0; k < sbcr->templates.count; ++k) {
+                if (mock_sib_matches(sbcr->templates.items[k], inserted->items[i]) == true) {
+                    mock_sib_triples_add(&new_triples, inserted->items[i]);
+                    break;
+                }
+            }
+        }
+
+        for (i = 0; i < removed->count; ++i) {
+            for (k = 0; k < sbcr->templates.count; ++k) {
+                if (mock_sib_matches(sbcr->templates.items[k], removed->items[i]) == true) {
+                    mock_sib_triples_add(&obsolete_triples, removed->items[i]);
+                    break;
+                }
+            }
+        }
+
+        if (new_triples.count > 0 || obsolete_triples.count > 0) {
+            mock_sib_send_indication(sib, number, &new_triples, &obsolete_triples);
+        }
+    }
+
+    mock_sib_triples_free(&new_triples, false);
+    mock_sib_triples_free(&obsolete_triples, false);
+}
+
+
+/** @brief Sends an indication to the subscription, called with the locked mutex. */
+static void mock_sib_send_indication(mock_sib_t *sib, int number,
+                                     mock_sib_triples_t *new_triples, mock_sib_triples_t *obsolete_triples)
+{
+    mock_sib_subscription_t *sbcr = &sib->subscriptions[number];
+    mock_sib_buffer_t message = {NULL, 0, 0, false};
+
+    mock_sib_buffer_format(&message,
+                           "<SSAP_message><transaction_type>SUBSCRIBE</transaction_type>"
+                           "<message_type>INDICATION</message_type>"
+                           "<transaction_id>%d</transaction_id>"
+                           "<node_id>%s</node_id><space_id>%s</space_id>"
+                           "<parameter name=\"ind_sequence\">%d</parameter>"
+                           "<parameter name=\"subscription_id\">%d</parameter>"
+                           "<parameter name=\"new_results\">",
+                           sbcr->sequence, sbcr->node_id, sbcr->space_id, sbcr->sequence, number);
+    mock_sib_buffer_triples(&message, new_triples);
+    mock_sib_buffer_format(&message, "</parameter><parameter name=\"obsolete_results\">");
+    mock_sib_buffer_triples(&message, obsolete_triples);
+    mock_sib_buffer_format(&message, "</parameter>" MOCK_SIB_END_TAG);
+
+    ++sbcr->sequence;
+
+    if (message.is_failed == false) {
+        mock_sib_output(sib, sbcr->socket, message.data, message.length, false);
+    }
+
+    free(message.data);
+}
+
+
+/**
+ * @brief Sends the message at once or queues it for the latency, called with the locked mutex.
+ * @return 0 on success or -1 otherwise.
+ */
+static int mock_sib_output(mock_sib_t *sib, int socket, const char *message, int length, bool is_closing)
+{
+    if (sib->latency_us == 0) {
+        return mock_sib_send(socket, message, length);
+    }
+
+    mock_sib_output_t *output = (mock_sib_output_t *) malloc(offsetof(mock_sib_output_t, data) + length);
+
+    if (output == NULL) {
+        return -1;
+    }
+
+    output->next = NULL;
+    output->socket = socket;
+    output->is_closing = is_closing;
+    output->length = length;
+    memcpy(output->data, message, length);
+
+    clock_gettime(CLOCK_MONOTONIC, &output->due);
+    output->due.tv_sec += sib->latency_us / 1000000;
+    output->due.tv_nsec += (long) (sib->latency_us % 1000000) * 1000;
+
+    if (output->due.tv_nsec >= 1000000000L) {
+        output->due.tv_nsec -= 1000000000L;
+        ++output->due.tv_sec;
+    }
+
+    if (sib->output_tail != NULL) {
+        sib->output_tail->next = output;
+    } else {
+        sib->output_head = output;
+        mock_sib_arm_timer(sib);
+    }
+
+    sib->output_tail = output;
+
+    return 0;
+}
+
+
+/** @brief Sends delayed messages that are due. */
+static void mock_sib_flush_output(mock_sib_t *sib)
+{
+    uint64_t expirations = 0;
+
+    if (read(sib->timer, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN) {
+        return;
+    }
+
+    while (true) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        pthread_mutex_lock(&sib->mutex);
+
+        mock_sib_output_t *output = sib->output_head;
+
+        if (output == NULL || output->due.tv_sec > now.tv_sec
+                || (output->due.tv_sec == now.tv_sec && output->due.tv_nsec > now.tv_nsec)) {
+            mock_sib_arm_timer(sib);
+            pthread_mutex_unlock(&sib->mutex);
+            return;
+        }
+
+        sib->output_head = output->next;
+
+        if (sib->output_head == NULL) {
+            sib->output_tail = NULL;
+        }
+
+        // Only this thread sends delayed messages, so the order is kept without the lock.
+        pthread_mutex_unlock(&sib->mutex);
+
+        mock_sib_send(output->socket, output->data, output->length);
+
+        if (output->is_closing == true && output->socket < sib->connections_capacity
+                && sib->connections[output->socket] != NULL) {
+            mock_sib_close(sib, output->socket);
+        }
+
+        free(output);
+    }
+}
+
+
+/** @brief Sets the timer to the first delayed message, called with the locked mutex. */
+static void mock_sib_arm_timer(mock_sib_t *sib)
+{
+    struct itimerspec timer;
+    memset(&timer, 0, sizeof(timer));
+
+    if (sib->output_head != NULL) {
+        timer.it_value = sib->output_head->due;
+    }
+
+    timerfd_settime(sib->timer, TFD_TIMER_ABSTIME, &timer, NULL);
+}
+
+
+static int mock_sib_send(int socket, const char *message, int length)
+{
+    int sent = 0;
+
+    while (sent < length) {
+        int bytes = send(socket, message + sent, length - sent, MSG_NOSIGNAL);
+
+        if (bytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return -1;
+        }
+
+        sent += bytes;
+    }
+
+    return 0;
+}
+
+
+/** @brief Copies contents of the first element with given name. */
+static bool mock_sib_get_tag(const char *message, const char *tag, char *value, int length)
+{
+    char open_tag[128];
+    char close_tag[128];
+
+    snprintf(open_tag, sizeof(open_tag), "<%s>", tag);
+    snprintf(close_tag, sizeof(close_tag), "</%s>", tag);
+
+    const char *begin = strstr(message, open_tag);
+
+    if (begin == NULL) {
+        return false;
+    }
+
+    begin += strlen(open_tag);
+
+    const char *end = strstr(begin, close_tag);
+
+    if (end == NULL || end - begin >= length) {
+        return false;
+    }
+
+    memcpy(value, begin, end - begin);
+    value[end - begin] = '\0';
+
+    return true;
+}
+
+
+/** @brief Copies contents of the parameter with given name attribute. */
+static bool mock_sib_get_parameter(const char *message, const char *name, char *value, int length)
+{
+    char quoted[128];
+
+    snprintf(quoted, sizeof(quoted), "\"%s\"", name);
+
+    const char *begin = strstr(message, quoted);
+
+    if (begin == NULL || (begin = strchr(begin, '>')) == NULL) {
+        return false;
+    }
+
+    ++begin;
+
+    const char *end = strchr(begin, '<');
+
+    if (end == NULL || end - begin >= length) {
+        return false;
+    }
+
+    memcpy(value, begin, end - begin);
+    value[end - begin] = '\0';
+
+    return true;
+}
+
+
+/** @brief Finds contents of the parameter with given name attribute (with nested elements). */
+static bool mock_sib_get_parameter_range(const char *message, const char *name, const char **begin, const char **end)
+{
+    char quoted[128];
+
+    snprintf(quoted, sizeof(quoted), "\"%s\"", name);
+
+    const char *found = strstr(message, quoted);
+
+    if (found == NULL || (found = strchr(found, '>')) == NULL) {
+        return false;
+    }
+
+    *begin = found + 1;
+    *end = strstr(*begin, "</parameter>");
+
+    return (*end != NULL);
+}
+
+
+/** @brief Copies XML text as plain text: CDATA sections and entities are decoded. */
+static int mock_sib_decode(const char *begin, const char *end, char *text)
+{
+    static const struct {
+        const char *entity;
+        char symbol;
+    } entities[] = {{"&lt;", '<'}, {"&gt;", '>'}, {"&amp;", '&'}, {"&quot;", '"'}, {"&apos;", '\''}};
+    char *start = text;
+
+    while (begin < end) {
+        if (*begin == '<' && strncmp(begin, "<![CDATA[", 9) == 0) {
+            const char *section_end = strstr(begin + 9, "]]>");
+
+            if (section_end == NULL || section_end > end) {
+                section_end = end;
+            }
+
+            memcpy(text, begin + 9, section_end - begin - 9);
+            text += section_end - begin - 9;
+            begin = section_end + 3;
+            continue;
+        }
+
+        if (*begin == '&') {
+            int i = 0;
+
+            for (i = 0; i < (int) (sizeof(entities) / sizeof(entities[0])); ++i) {
+                int length = (int) strlen(entities[i].entity);
+
+                if (end - begin >= length && strncmp(begin, entities[i].entity, length) == 0) {
+                    break;
+                }
+            }
+
+            if (i < (int) (sizeof(entities) / sizeof(entities[0]))) {
+                *text++ = entities[i].symbol;
+                begin += strlen(entities[i].entity);
+                continue;
+            }
+        }
+
+        *text++ = *begin++;
+    }
+
+    *text = '\0';
+
+    return (int) (text - start);
+}
+
+
+/** @brief Calculates FNV-1a hash of the string, continues the given hash. */
+static unsigned int mock_sib_hash(const char *text, unsigned int hash)
+{
+    for (; *text != '\0'; ++text) {
+        hash ^= (unsigned char) *text;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+
+/** @brief Creates a triple, strings are decoded from XML if is_encoded is true. */
+static mock_sib_triple_t *mock_sib_new_triple(const char *subject, int subject_length, int subject_type,
+                                              const char *predicate, int predicate_length,
+                                              const char *object, int object_length, int object_type,
+                                              bool is_encoded)
+{
+    mock_sib_triple_t *triple = (mock_sib_triple_t *)
+            malloc(sizeof(mock_sib_triple_t) + subject_length + predicate_length + object_length + 3);
+
+    if (triple == NULL) {
+        return NULL;
+    }
+
+    memset(triple, 0, sizeof(mock_sib_triple_t));
+
+    triple->subject = (char *) (triple + 1);
+    triple->predicate = triple->subject + subject_length + 1;
+    triple->object = triple->predicate + predicate_length + 1;
+    triple->subject_type = subject_type;
+    triple->object_type = object_type;
+
+    if (is_encoded == true) {
+        mock_sib_decode(subject, subject + subject_length, triple->subject);
+        mock_sib_decode(predicate, predicate + predicate_length, triple->predicate);
+        mock_sib_decode(object, object + object_length, triple->object);
+    } else {
+        memcpy(triple->subject, subject, subject_length);
+        triple->subject[subject_length] = '\0';
+        memcpy(triple->predicate, predicate, predicate_length);
+        triple->predicate[predicate_length] = '\0';
+        memcpy(triple->object, object, object_length);
+        triple->object[object_length] = '\0';
+    }
+
+    if (strcmp(triple->subject, MOCK_SIB_ANY) == 0) {
+        triple->any |= MOCK_SIB_ANY_SUBJECT;
+    }
+
+    if (strcmp(triple->predicate, MOCK_SIB_ANY) == 0) {
+        triple->any |= MOCK_SIB_ANY_PREDICATE;
+    }
+
+    if (strcmp(triple->object, MOCK_SIB_ANY) == 0 && object_type == MOCK_SIB_URI) {
+        triple->any |= MOCK_SIB_ANY_OBJECT;
+    }
+
+    triple->subject_hash = mock_sib_hash(triple->subject, 2166136261u);
+    triple->hash = mock_sib_hash(triple->object, mock_sib_hash(triple->predicate, triple->subject_hash * 16777619u)
+                                 * 16777619u) ^ (unsigned int) object_type;
+
+    return triple;
+}
+
+
+/** @brief Gets type of the subject or object by the start tag. */
+static int mock_sib_get_type(const char *tag, const char *tag_end)
+{
+    char text[64];
+    int length = (int) (tag_end - tag);
+
+    if (length >= (int) sizeof(text)) {
+        length = sizeof(text) - 1;
+    }
+
+    memcpy(text, tag, length);
+    text[length] = '\0';
+
+    if (strstr(text, "literal") != NULL) {
+        return MOCK_SIB_LITERAL;
+    }
+
+    if (strstr(text, "bnode") != NULL) {
+        return MOCK_SIB_BNODE;
+    }
+
+    return MOCK_SIB_URI;
+}
+
+
+/**
+ * @brief Parses triples of an RDF-M3 triple list.
+ * @return 0 on success or -1 otherwise (parsed triples stay in the array).
+ */
+static int mock_sib_parse_triples(const char *begin, const char *end, mock_sib_triples_t *triples)
+{
+    const char *cursor = begin;
+
+    while ((cursor = strstr(cursor, "<triple>")) != NULL && cursor < end) {
+        const char *subject = strstr(cursor, "<subject");
+        const char *subject_text = (subject != NULL) ? strchr(subject, '>') : NULL;
+        const char *subject_end = (subject_text != NULL) ? strstr(subject_text, "</subject>") : NULL;
+        const char *predicate = (subject_end != NULL) ? strstr(subject_end, "<predicate>") : NULL;
+        const char *predicate_end = (predicate != NULL) ? strstr(predicate, "</predicate>") : NULL;
+        const char *object = (predicate_end != NULL) ? strstr(predicate_end, "<object") : NULL;
+        const char *object_text = (object != NULL) ? strchr(object, '>') : NULL;
+        const char *object_end = (object_text != NULL) ? strstr(object_text, "</object>") : NULL;
+
+        if (object_end == NULL || object_end > end) {
+            return -1;
+        }
+
+        ++subject_text;
+        predicate += strlen("<predicate>");
+        ++object_text;
+
+        mock_sib_triple_t *triple = mock_sib_new_triple(subject_text, (int) (subject_end - subject_text),
+                                                        mock_sib_get_type(subject, subject_text),
+                                                        predicate, (int) (predicate_end - predicate),
+                                                        object_text, (int) (object_end - object_text),
+                                                        mock_sib_get_type(object, object_text), true);
+
+        if (triple == NULL || mock_sib_triples_add(triples, triple) != 0) {
+            free(triple);
+            return -1;
+        }
+
+        cursor = object_end;
+    }
+
+    return 0;
+}
+
+
+/** @brief Checks if the triple matches the template (wildcards match anything). */
+static bool mock_sib_matches(const mock_sib_triple_t *triple_template, const mock_sib_triple_t *triple)
+{
+    if ((triple_template->any & MOCK_SIB_ANY_SUBJECT) == 0
+            && (triple_template->subject_hash != triple->subject_hash
+                || strcmp(triple_template->subject, triple->subject) != 0)) {
+        return false;
+    }
+
+    if ((triple_template->any & MOCK_SIB_ANY_PREDICATE) == 0
+            && strcmp(triple_template->predicate, triple->predicate) != 0) {
+        return false;
+    }
+
+    if ((triple_template->any & MOCK_SIB_ANY_OBJECT) == 0
+            && (triple_template->object_type != triple->object_type
+                || strcmp(triple_template->object, triple->object) != 0)) {
+        return false;
+    }
+
+    return true;
+}
+
+
+static int mock_sib_triples_add(mock_sib_triples_t *triples, mock_sib_triple_t *triple)
+{
+    if (triples->count == triples->capacity) {
+        int capacity = triples->capacity * 2 + 16;
+        mock_sib_triple_t **items = (mock_sib_triple_t **)
+                realloc(triples->items, capacity * sizeof(mock_sib_triple_t *));
+
+        if (items == NULL) {
+            return -1;
+        }
+
+        triples->items = items;
+        triples->capacity = capacity;
+    }
+
+    triples->items[triples->count++] = triple;
+
+    return 0;
+}
+
+
+static void mock_sib_triples_free(mock_sib_triples_t *triples, bool with_triples)
+{
+    int i = 0;
+
+    if (with_triples == true) {
+        for (i = 0; i < triples->count; ++i) {
+            free(triples->items[i]);
+        }
+    }
+
+    free(triples->items);
+
+    triples->items = NULL;
+    triples->count = 0;
+    triples->capacity = 0;
+}
+
+
+static bool mock_sib_store_init(mock_sib_store_t *store)
+{
+    store->capacity = MOCK_SIB_STORE_INITIAL_CAPACITY;
+    store->count = 0;
+    store->mark = 0;
+    store->buckets = (mock_sib_triple_t **) calloc(store->capacity, sizeof(mock_sib_triple_t *));
+    store->subject_buckets = (mock_sib_triple_t **) calloc(store->capacity, sizeof(mock_sib_triple_t *));
+
+    return (store->buckets != NULL && store->subject_buckets != NULL);
+}
+
+
+static void mock_sib_store_free(mock_sib_store_t *store)
+{
+    unsigned int i = 0;
+
+    for (i = 0; store->buckets != NULL && i < store->capacity; ++i) {
+        while (store->buckets[i] != NULL) {
+            mock_sib_triple_t *triple = store->buckets[i];
+            store->buckets[i] = triple->next;
+            free(triple);
+        }
+    }
+
+    free(store->buckets);
+    free(store->subject_buckets);
+
+    store->buckets = NULL;
+    store->subject_buckets = NULL;
+    store->count = 0;
+}
+
+
+/** @brief Doubles count of buckets, the store stays as it is if memory is not allocated. */
+static void mock_sib_store_grow(mock_sib_store_t *store)
+{
+    unsigned int capacity = store->capacity * 2;
+    mock_sib_triple_t **buckets = (mock_sib_triple_t **) calloc(capacity, sizeof(mock_sib_triple_t *));
+    mock_sib_triple_t **subject_buckets = (mock_sib_triple_t **) calloc(capacity, sizeof(mock_sib_triple_t *));
+    unsigned int i = 0;
+
+    if (buckets == NULL || subject_buckets == NULL) {
+        free(buckets);
+        free(subject_buckets);
+        return;
+    }
+
+    for (i = 0; i < store->capacity; ++i) {
+        while (store->buckets[i] != NULL) {
+            mock_sib_triple_t *triple = store->buckets[i];
+            store->buckets[i] = triple->next;
+
+            triple->next = buckets[triple->hash & (capacity - 1)];
+            buckets[triple->hash & (capacity - 1)] = triple;
+            triple->next_subject = subject_buckets[triple->subject_hash & (capacity - 1)];
+            subject_buckets[triple->subject_hash & (capacity - 1)] = triple;
+        }
+    }
+
+    free(store->buckets);
+    free(store->subject_buckets);
+
+    store->buckets = buckets;
+    store->subject_buckets = subject_buckets;
+    store->capacity = capacity;
+}
+
+
+/**
+ * @brief Adds the triple to the store.
+ * @return true if the triple is added or false if the store has the same triple.
+ */
+static bool mock_sib_store_add(mock_sib_store_t *store, mock_sib_triple_t *triple)
+{
+    mock_sib_triple_t *stored = store->buckets[triple->hash & (store->capacity - 1)];
+
+    for (; stored != NULL; stored = stored->next) {
+        if (stored->hash == triple->hash && stored->object_type == triple->object_type
+                && strcmp(stored->subject, triple->subject) == 0
+                && strcmp(stored->predicate, triple->predicate) == 0
+                && strcmp(stored->object, triple->object) == 0) {
+            return false;
+        }
+    }
+
+    if ((unsigned int) store->count >= store->capacity) {
+        mock_sib_store_grow(store);
+    }
+
+    triple->any = 0;
+    triple->mark = store->mark;
+    triple->next = store->buckets[triple->hash & (store->capacity - 1)];
+    store->buckets[triple->hash & (store->capacity - 1)] = triple;
+    triple->next_subject = store->subject_buckets[triple->subject_hash & (store->capacity - 1)];
+    store->subject_buckets[triple->subject_hash & (store->capacity - 1)] = triple;
+    ++store->count;
+
+    return true;
+}
+
+
+/** @brief Removes the stored triple from the store, the triple isn't freed. */
+static void mock_sib_store_unlink(mock_sib_store_t *store, mock_sib_triple_t *triple)
+{
+    mock_sib_triple_t **link = &store->buckets[triple->hash & (store->capacity - 1)];
+
+    while (*link != triple) {
+        link = &(*link)->next;
+    }
+
+    *link = triple->next;
+
+    link = &store->subject_buckets[triple->subject_hash & (store->capacity - 1)];
+
+    while (*link != triple) {
+        link = &(*link)->next_subject;
+    }
+
+    *link = triple->next_subject;
+
+    --store->count;
+}
+
+
+/**
+ * @brief Finds stored triples that match the template.
+ *
+ * Triples that are found already by the current request (store mark) are skipped.
+ *
+ * @return 0 on success or -1 otherwise.
+ */
+static int mock_sib_store_query(mock_sib_store_t *store, const mock_sib_triple_t *triple_template,
+                                mock_sib_triples_t *found)
+{
+    mock_sib_triple_t *triple = NULL;
+    unsigned int i = 0;
+
+    if ((triple_template->any & MOCK_SIB_ANY_SUBJECT) == 0) {
+        triple = store->subject_buckets[triple_template->subject_hash & (store->capacity - 1)];
+
+        for (; triple != NULL; triple = triple->next_subject) {
+            if (triple->mark != store->mark && mock_sib_matches(triple_template, triple) == true) {
+                if (mock_sib_triples_add(found, triple) != 0) {
+                    return -1;
+                }
+
+                triple->mark = store->mark;
+            }
+        }
+
+        return 0;
+    }
+
+    for (i = 0; i < store->capacity; ++i) {
+        for (triple = store->buckets[i]; triple != NULL; triple = triple->next) {
+            if (triple->mark != store->mark && mock_sib_matches(triple_template, triple) == true) {
+                if (mock_sib_triples_add(found, triple) != 0) {
+                    return -1;
+                }
+
+                triple->mark = store->mark;
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+static void mock_sib_buffer_append(mock_sib_buffer_t *buffer, const char *data, int length)
+{
+    if (buffer->is_failed == true) {
+        return;
+    }
+
+    if (buffer->length + length + 1 > buffer->capacity) {
+        int capacity = (buffer->length + length + 1) * 2;
+        char *text = (char *) realloc(buffer->data, capacity);
+
+        if (text == NULL) {
+            buffer->is_failed = true;
+            return;
+        }
+
+        buffer->data = text;
+        buffer->capacity = capacity;
+    }
+
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+    buffer->data[buffer->length] = '\0';
+}
+
+
+static void mock_sib_buffer_format(mock_sib_buffer_t *buffer, const char *format, ...)
+{
+    char text[1024];
+    va_list arguments;
+
+    va_start(arguments, format);
+    int length = vsnprintf(text, sizeof(text), format, arguments);
+    va_end(arguments);
+
+    if (length < 0 || length >= (int) sizeof(text)) {
+        buffer->is_failed = true;
+        return;
+    }
+
+    mock_sib_buffer_append(buffer, text, length);
+}
+
+
+/** @brief Appends text with escaped markup characters. */
+static void mock_sib_buffer_escape(mock_sib_buffer_t *buffer, const char *text)
+{
+    const char *begin = text;
+
+    for (; *text != '\0'; ++text) {
+        const char *entity = (*text == '<') ? "&lt;" : (*text == '>') ? "&gt;" : (*text == '&') ? "&amp;" : NULL;
+
+        if (entity != NULL) {
+            mock_sib_buffer_append(buffer, begin, (int) (text - begin));
+            mock_sib_buffer_append(buffer, entity, (int) strlen(entity));
+            begin = text + 1;
+        }
+    }
+
+    mock_sib_buffer_append(buffer, begin, (int) (text - begin));
+}
+
+
+/** @brief Appends an RDF-M3 triple list. */
+static void mock_sib_buffer_triples(mock_sib_buffer_t *buffer, mock_sib_triples_t *triples)
+{
+    static const char *types[] = {"uri", "literal", "bnode"};
+    int i = 0;
+
+    mock_sib_buffer_format(buffer, "<triple_list>");
+
+    for (i = 0; i < triples->count; ++i) {
+        mock_sib_triple_t *triple = triples->items[i];
+
+        mock_sib_buffer_format(buffer, "<triple><subject type=\"%s\">", types[triple->subject_type]);
+        mock_sib_buffer_escape(buffer, triple->subject);
+        mock_sib_buffer_format(buffer, "</subject><predicate>");
+        mock_sib_buffer_escape(buffer, triple->predicate);
+        mock_sib_buffer_format(buffer, "</predicate><object type=\"%s\">", types[triple->object_type]);
+        mock_sib_buffer_escape(buffer, triple->object);
+        mock_sib_buffer_format(buffer, "</object></triple>");
+    }
+
+    mock_sib_buffer_format(buffer, "</triple_list>");
+}
@@ -0,0 +1,134 @@
+/**
+ * @file   mock_sib.h
+ * @brief  In-process stand-in for the smart space (SIB) for benchmarks.
+ *
+ *
+ * @section LICENSE
+ *
+ * SmartSlog KP Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SmartSlog KP Library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SmartSlog KP Library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * The mock SIB listens on the loopback interface and speaks the part of
+ * SSAP over TCP that is needed by benchmarks: JOIN, LEAVE, INSERT, UPDATE,
+ * REMOVE, QUERY (RDF-M3 templates and SPARQL SELECT with one triple
+ * pattern), SUBSCRIBE and UNSUBSCRIBE. Graphs are accepted in RDF-M3
+ * encoding only.
+ *
+ * Triples are kept in memory (hashed by the whole triple and by the
+ * subject). Subscriptions with RDF-M3 templates get indications when
+ * INSERT, UPDATE and REMOVE change matching triples. Indications can also
+ * be sent on demand by #mock_sib_indicate (for any subscription).
+ *
+ * All connections are served by one thread (epoll), so the SIB does not add
+ * latency that depends on the count of connections. Network latency is
+ * emulated by #mock_sib_set_latency.
+ */
+
+#ifndef _MOCK_SIB_H
+#define _MOCK_SIB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Running mock SIB. */
+typedef struct mock_sib_s mock_sib_t;
+
+
+/**
+ * @brief Starts the mock SIB on 127.0.0.1.
+ * @param port. Port to listen or 0 to select a free port.
+ * @return mock SIB on success or NULL otherwise.
+ */
+mock_sib_t *mock_sib_start(int port);
+
+/**
+ * @brief Stops the mock SIB, closes all connections and frees it.
+ * @param sib. Mock SIB.
+ */
+void mock_sib_stop(mock_sib_t *sib);
+
+/**
+ * @brief Gets the port of the mock SIB.
+ * @param sib. Mock SIB.
+ * @return listening port.
+ */
+int mock_sib_port(mock_sib_t *sib);
+
+/**
+ * @brief Gets count of subscriptions that were made (including closed ones).
+ * @param sib. Mock SIB.
+ * @return count of subscriptions.
+ */
+int mock_sib_subscriptions_count(mock_sib_t *sib);
+
+/**
+ * @brief Sends an indication with one new triple to the subscription.
+ *
+ * Subscriptions are numbered from 0 in the order of subscribing,
+ * the number is also used as the subscription ID.
+ *
+ * @param sib. Mock SIB.
+ * @param subscription. Number of the subscription.
+ * @param subject. Subject (URI) of the new triple.
+ * @param predicate. Predicate of the new triple.
+ * @param object. Object (literal) of the new triple.
+ * @return 0 on success or -1 otherwise (no such subscription or it is closed).
+ */
+int mock_sib_indicate(mock_sib_t *sib, int subscription,
+                      const char *subject, const char *predicate, const char *object);
+
+/**
+ * @brief Sets the delay of confirmations and indications (network latency).
+ *
+ * Messages are sent in the order they are made, each one after the delay
+ * since it is made. Set the delay before clients connect.
+ *
+ * @param sib. Mock SIB.
+ * @param latency_us. Delay, microseconds (0 - messages are sent at once).
+ */
+void mock_sib_set_latency(mock_sib_t *sib, int latency_us);
+
+/**
+ * @brief Adds generated triples to the smart space.
+ *
+ * Subjects of triples are the prefix with numbers 0..count-1, objects are
+ * literals of the payload size. No indications are sent.
+ *
+ * @param sib. Mock SIB.
+ * @param subject_prefix. Prefix of subjects (URI).
+ * @param predicate. Predicate of triples.
+ * @param count. Count of triples.
+ * @param payload_size. Length of objects, bytes.
+ * @return 0 on success or -1 otherwise.
+ */
+int mock_sib_generate(mock_sib_t *sib, const char *subject_prefix, const char *predicate,
+                      int count, int payload_size);
+
+/**
+ * @brief Gets count of triples in the smart space.
+ * @param sib. Mock SIB.
+ * @return count of triples.
+ */
+int mock_sib_triples_count(mock_sib_t *sib);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MOCK_SIB_H */
@@ -0,0 +1,260 @@
+/**
+ * @file   sbcr_latency.c
+ * @brief  Benchmark: delivery latency of asynchronous subscriptions.
+ *
+ *
+ * @section LICENSE
+ *
+ * SmartSlog KP Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SmartSlog KP Library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SmartSlog KP Library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * The benchmark makes a given count of asynchronous subscriptions to the
+ * mock SIB and measures time from sending an indication by the SIB to the
+ * call of the changed handler. Indications are sent one at a time to
+ * subscriptions spread over the whole list (the last one is included).
+ *
+ * Usage: sbcr_latency [indications] [subscriptions count]...
+ * By default 200 indications for 10, 100 and 500 subscriptions.
+ *
+ * With epoll reactor latency does not depend on the count of subscriptions.
+ * Build the library with SSLOG_SBCR_NO_EPOLL to compare with the thread
+ * that checks subscriptions one by one (use small counts, each quiet
+ * subscription is checked for KPLIB_SBCR_ASYNC_WAITING_TIMEOUT).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "smartslog.h"
+#include "mock_sib.h"
+
+
+#define BENCH_SPACE_ID "X"
+#define BENCH_SUBJECT_FORMAT "http://smartslog/bench#subject%d"
+#define BENCH_PREDICATE "http://smartslog/bench#value"
+
+/** @brief Maximum time to wait one indication, seconds. */
+#define BENCH_WAIT_TIMEOUT 120
+
+
+/** @brief Indication that the benchmark waits for. */
+static struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int expected_id;        /**< ID of the subscription in the mock SIB. */
+    bool is_received;
+    struct timespec received_at;
+} g_waiting = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, -1, false, {0, 0}};
+
+
+static double elapsed_us(const struct timespec *from, const struct timespec *to)
+{
+    return (to->tv_sec - from->tv_sec) * 1e6 + (to->tv_nsec - from->tv_nsec) / 1e3;
+}
+
+
+static int compare_doubles(const void *a, const void *b)
+{
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+
+    return (x > y) - (x < y);
+}
+
+
+static double percentile(const double *sorted, int count, double p)
+{
+    int index = (int) (p * (count - 1) + 0.5);
+
+    return sorted[index];
+}
+
+
+static void on_changed(sslog_subscription_t *subscription)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    int id = atoi(sslog_sbcr_get_id(subscription));
+
+    pthread_mutex_lock(&g_waiting.mutex);
+
+    if (id == g_waiting.expected_id) {
+        g_waiting.is_received = true;
+        g_waiting.received_at = now;
+        pthread_cond_signal(&g_waiting.cond);
+    }
+
+    pthread_mutex_unlock(&g_waiting.mutex);
+}
+
+
+/**
+ * @brief Runs one round: subscribes, measures and unsubscribes.
+ * @return 0 on success or -1 otherwise.
+ */
+static int run_round(mock_sib_t *sib, sslog_node_t *node, int subscriptions_count, int indications)
+{
+    sslog_subscription_t **subscriptions = (sslog_subscription_t **)
+            calloc(subscriptions_count, sizeof(sslog_subscription_t *));
+    double *latencies = (double *) calloc(indications, sizeof(double));
+    char subject[128];
+    int result = 0;
+    int i = 0;
+
+    // IDs of the mock SIB continue between rounds.
+    int first_id = mock_sib_subscriptions_count(sib);
+
+    for (i = 0; i < subscriptions_count; ++i) {
+        snprintf(subject, sizeof(subject), BENCH_SUBJECT_FORMAT, first_id + i);
+
+        sslog_triple_t *triple_template = sslog_new_triple_detached(subject, SSLOG_TRIPLE_ANY, SSLOG_TRIPLE_ANY,
+                                                                    SSLOG_RDF_TYPE_URI, SSLOG_RDF_TYPE_URI);
+
+        subscriptions[i] = sslog_new_subscription(node, true);
+        sslog_sbcr_add_triple_template(subscriptions[i], triple_template);
+        sslog_sbcr_set_changed_handler(subscriptions[i], on_changed);
+        sslog_free_triple(triple_template);
+
+        if (sslog_sbcr_subscribe(subscriptions[i]) != SSLOG_ERROR_NO) {
+            fprintf(stderr, "Can't subscribe: %s\n", sslog_error_get_last_text());
+            subscriptions_count = i;
+            result = -1;
+            break;
+        }
+    }
+
+    for (i = 0; i < indications && result == 0; ++i) {
+        // Spread targets over all subscriptions, the last one goes first.
+        int target = (i == 0) ? subscriptions_count - 1 : (int) ((i * 7919L) % subscriptions_count);
+        int id = first_id + target;
+        struct timespec sent_at;
+        struct timespec deadline;
+
+        snprintf(subject, sizeof(subject), BENCH_SUBJECT_FORMAT, id);
+
+        pthread_mutex_lock(&g_waiting.mutex);
+        g_waiting.expected_id = id;
+        g_waiting.is_received = false;
+        pthread_mutex_unlock(&g_waiting.mutex);
+
+        clock_gettime(CLOCK_MONOTONIC, &sent_at);
+
+        if (mock_sib_indicate(sib, id, subject, BENCH_PREDICATE, "value") != 0) {
+            fprintf(stderr, "Can't send indication to subscription %d\n", id);
+            result = -1;
+            break;
+        }
+
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += BENCH_WAIT_TIMEOUT;
+
+        pthread_mutex_lock(&g_waiting.mutex);
+
+        while (g_waiting.is_received == false) {
+            if (pthread_cond_timedwait(&g_waiting.cond, &g_waiting.mutex, &deadline) != 0) {
+                break;
+            }
+        }
+
+        if (g_waiting.is_received == true) {
+            latencies[i] = elapsed_us(&sent_at, &g_waiting.received_at);
+        } else {
+            fprintf(stderr, "Indication for subscription %d is not received\n", id);
+            result = -1;
+        }
+
+        g_waiting.expected_id = -1;
+
+        pthread_mutex_unlock(&g_waiting.mutex);
+    }
+
+    if (result == 0) {
+        qsort(latencies, indications, sizeof(double), compare_doubles);
+
+        printf("subscriptions=%d indications=%d p50_us=%.1f p99_us=%.1f max_us=%.1f\n",
+               subscriptions_count, indications,
+               percentile(latencies, indications, 0.5),
+               percentile(latencies, indications, 0.99),
+               latencies[indications - 1]);
+        fflush(stdout);
+    }
+
+    for (i = 0; i < subscriptions_count; ++i) {
+        sslog_sbcr_unsubscribe(subscriptions[i]);
+        sslog_free_subscription(subscriptions[i]);
+    }
+
+    free(latencies);
+    free(subscriptions);
+
+    return result;
+}
+
+
+int main(int argc, char *argv[])
+{
+    int indications = (argc > 1) ? atoi(argv[1]) : 200;
+    int default_counts[] = {10, 100, 500};
+    int rounds = (argc > 2) ? argc - 2 : (int) (sizeof(default_counts) / sizeof(default_counts[0]));
+    int result = 0;
+    int i = 0;
+
+    if (indications <= 0) {
+        fprintf(stderr, "Usage: %s [indications] [subscriptions count]...\n", argv[0]);
+        return 1;
+    }
+
+    mock_sib_t *sib = mock_sib_start(0);
+
+    if (sib == NULL) {
+        return 1;
+    }
+
+    sslog_init();
+
+    sslog_node_t *node = sslog_new_node("sbcr_latency", BENCH_SPACE_ID, "127.0.0.1", mock_sib_port(sib));
+
+    if (node == NULL || sslog_node_join(node) != SSLOG_ERROR_NO) {
+        fprintf(stderr, "Can't join: %s\n", sslog_error_get_last_text());
+        mock_sib_stop(sib);
+        return 1;
+    }
+
+    for (i = 0; i < rounds && result == 0; ++i) {
+        int count = (argc > 2) ? atoi(argv[i + 2]) : default_counts[i];
+
+        if (count <= 0) {
+            fprintf(stderr, "Incorrect count of subscriptions: %s\n", argv[i + 2]);
+            result = -1;
+            break;
+        }
+
+        result = run_round(sib, node, count, indications);
+    }
+
+    sslog_node_leave(node);
+    sslog_shutdown();
+
+    mock_sib_stop(sib);
+
+    return (result == 0) ? 0 : 1;
+}
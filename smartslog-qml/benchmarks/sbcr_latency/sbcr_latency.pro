@@ -0,0 +1,13 @@
+TEMPLATE = app
+TARGET = sbcr_latency
+
+CONFIG += console
+CONFIG -= app_bundle qt
+
+include(../../vendor/SmartSlog/smartslog.pri)
+
+INCLUDEPATH += ../common
+
+SOURCES += \
+    sbcr_latency.c \
+    ../common/mock_sib.c
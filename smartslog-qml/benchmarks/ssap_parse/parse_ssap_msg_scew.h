@@ -0,0 +1,39 @@
+/**
+ * @file   parse_ssap_msg_scew.h
+ * @brief  Previous (scew tree based) parser of SSAP messages.
+ *
+ *
+ * @section LICENSE
+ *
+ * SmartSlog KP Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SmartSlog KP Library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SmartSlog KP Library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * The functions have the same behaviour as parse_ssap_msg() and
+ * parse_sparql_xml_result() had before the streaming parser.
+ * Fields of the message info that are not in the message are not set.
+ */
+
+#ifndef _PARSE_SSAP_MSG_SCEW_H
+#define _PARSE_SSAP_MSG_SCEW_H
+
+#include <ckpi/parse_ssap_msg.h>
+
+int parse_ssap_msg_scew(char *xml, int len, ssap_msg_t *msg);
+int parse_sparql_xml_result_scew(char *xml, ss_sparql_result_t **result, int *number_of_bindings);
+
+#endif /* _PARSE_SSAP_MSG_SCEW_H */
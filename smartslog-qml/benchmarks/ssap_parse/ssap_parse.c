@@ -0,0 +1,337 @@
+/**
+ * @file   ssap_parse.c
+ * @brief  Benchmark: parsing of SSAP messages, streaming parser vs scew tree.
+ *
+ *
+ * @section LICENSE
+ *
+ * SmartSlog KP Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SmartSlog KP Library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SmartSlog KP Library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * Each message is parsed by the previous parser (scew tree), by the
+ * streaming parser with the whole message and by the streaming parser
+ * with parts of the message (as they come from TCP). Before measuring
+ * results of both parsers are compared.
+ *
+ * Usage: ssap_parse [iterations] [message file]...
+ * By default 2000 iterations for messages from the messages directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include <ckpi/ckpi.h>
+#include <ckpi/parse_ssap_msg.h>
+
+#include "parse_ssap_msg_scew.h"
+
+
+#ifndef SSAP_PARSE_MESSAGES_DIR
+#define SSAP_PARSE_MESSAGES_DIR "messages"
+#endif
+
+/** @brief Size of parts for the streaming parser (TCP segment). */
+#define SSAP_PARSE_PART_SIZE 1448
+
+
+static const char *g_default_messages[] = {
+    "join_confirm.xml",
+    "insert_confirm_bnodes.xml",
+    "indication_1.xml",
+    "indication_50.xml",
+    "query_confirm_200.xml",
+    "sparql_select_200.xml",
+    "sparql_construct_100.xml",
+    NULL
+};
+
+
+static double now_us()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec * 1e6 + now.tv_nsec / 1e3;
+}
+
+
+static char *load_file(const char *path, int *len)
+{
+    FILE *file = fopen(path, "rb");
+
+    if (file == NULL) {
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    *len = (int) ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char *data = (char *) malloc(*len + 1);
+
+    if (data != NULL && fread(data, 1, *len, file) != (size_t) *len) {
+        free(data);
+        data = NULL;
+    }
+
+    if (data != NULL) {
+        data[*len] = '\0';
+    }
+
+    fclose(file);
+
+    return data;
+}
+
+
+static void free_msg(ssap_msg_t *msg)
+{
+    ss_delete_triples(msg->n_result);
+    ss_delete_triples(msg->o_result);
+    ss_delete_sparql_results(msg->n_sparql_select_result, msg->number_of_bindings);
+    ss_delete_sparql_results(msg->o_sparql_select_result, msg->number_of_bindings);
+
+    while (msg->bnodes != NULL) {
+        bnode_tmp_t *bnode = msg->bnodes;
+        msg->bnodes = bnode->next;
+        free(bnode);
+    }
+}
+
+
+static int parse_scew(char *xml, int len, ssap_msg_t *msg)
+{
+    memset(msg, 0, sizeof(ssap_msg_t));
+    msg->n_bool_result = 1;
+    msg->o_bool_result = 1;
+
+    return parse_ssap_msg_scew(xml, len, msg);
+}
+
+
+static int parse_parts(const char *xml, int len, ssap_msg_t *msg)
+{
+    ssap_parser_t *parser = ssap_parser_new(msg);
+    int status = 0;
+    int offset = 0;
+
+    while (status == 0 && offset < len) {
+        int part = (len - offset < SSAP_PARSE_PART_SIZE) ? len - offset : SSAP_PARSE_PART_SIZE;
+
+        status = ssap_parser_feed(parser, xml + offset, part);
+        offset += part;
+    }
+
+    ssap_parser_free(parser);
+
+    return (status == 1) ? 0 : -1;
+}
+
+
+static int compare_triples(const ss_triple_t *a, const ss_triple_t *b)
+{
+    for (; a != NULL && b != NULL; a = a->next, b = b->next) {
+        if (strcmp(a->subject, b->subject) != 0
+                || strcmp(a->predicate, b->predicate) != 0
+                || strcmp(a->object, b->object) != 0
+                || a->subject_type != b->subject_type
+                || a->object_type != b->object_type) {
+            return -1;
+        }
+    }
+
+    return (a == NULL && b == NULL) ? 0 : -1;
+}
+
+
+static int compare_rows(const ss_sparql_result_t *a, const ss_sparql_result_t *b, int number_of_bindings)
+{
+    for (; a != NULL && b != NULL; a = a->next, b = b->next) {
+        int i = 0;
+
+        for (i = 0; i < number_of_bindings; ++i) {
+            if (strcmp(a->name[i], b->name[i]) != 0
+                    || a->type[i] != b->type[i]
+                    || (a->type[i] != SS_RDF_TYPE_UNBOUND && strcmp(a->value[i], b->value[i]) != 0)) {
+                return -1;
+            }
+        }
+    }
+
+    return (a == NULL && b == NULL) ? 0 : -1;
+}
+
+
+static int compare_msgs(const ssap_msg_t *a, const ssap_msg_t *b)
+{
+    const bnode_tmp_t *bnode_a = a->bnodes;
+    const bnode_tmp_t *bnode_b = b->bnodes;
+
+    if (strcmp(a->message_type, b->message_type) != 0
+            || strcmp(a->transaction_type, b->transaction_type) != 0
+            || strcmp(a->transaction_id, b->transaction_id) != 0
+            || strcmp(a->node_id, b->node_id) != 0
+            || strcmp(a->space_id, b->space_id) != 0
+            || strcmp(a->transaction_status, b->transaction_status) != 0
+            || strcmp(a->subscribe_id, b->subscribe_id) != 0
+            || a->number_of_bindings != b->number_of_bindings
+            || a->n_bool_result != b->n_bool_result
+            || a->o_bool_result != b->o_bool_result) {
+        return -1;
+    }
+
+    for (; bnode_a != NULL && bnode_b != NULL; bnode_a = bnode_a->next, bnode_b = bnode_b->next) {
+        if (strcmp(bnode_a->label, bnode_b->label) != 0 || strcmp(bnode_a->uri, bnode_b->uri) != 0) {
+            return -1;
+        }
+    }
+
+    if (bnode_a != NULL || bnode_b != NULL
+            || compare_triples(a->n_result, b->n_result) != 0
+            || compare_triples(a->o_result, b->o_result) != 0
+            || compare_rows(a->n_sparql_select_result, b->n_sparql_select_result, a->number_of_bindings) != 0
+            || compare_rows(a->o_sparql_select_result, b->o_sparql_select_result, a->number_of_bindings) != 0) {
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/**
+ * @brief Checks results of parsers and measures them for one message.
+ * @return 0 on success or -1 otherwise.
+ */
+static int run_message(const char *name, char *xml, int len, int iterations)
+{
+    ssap_msg_t expected;
+    ssap_msg_t actual;
+    ssap_msg_t parts;
+    int i = 0;
+
+    if (parse_scew(xml, len, &expected) != 0
+            || parse_ssap_msg(xml, len, &actual) != 0
+            || parse_parts(xml, len, &parts) != 0) {
+        fprintf(stderr, "%s: can't parse the message\n", name);
+        return -1;
+    }
+
+    int is_same = (compare_msgs(&expected, &actual) == 0 && compare_msgs(&expected, &parts) == 0);
+
+    free_msg(&expected);
+    free_msg(&actual);
+    free_msg(&parts);
+
+    if (!is_same) {
+        fprintf(stderr, "%s: results of parsers are different\n", name);
+        return -1;
+    }
+
+    double started = now_us();
+
+    for (i = 0; i < iterations; ++i) {
+        parse_scew(xml, len, &expected);
+        free_msg(&expected);
+    }
+
+    double scew_us = (now_us() - started) / iterations;
+
+    started = now_us();
+
+    for (i = 0; i < iterations; ++i) {
+        parse_ssap_msg(xml, len, &actual);
+        free_msg(&actual);
+    }
+
+    double stream_us = (now_us() - started) / iterations;
+
+    started = now_us();
+
+    for (i = 0; i < iterations; ++i) {
+        parse_parts(xml, len, &parts);
+        free_msg(&parts);
+    }
+
+    double parts_us = (now_us() - started) / iterations;
+
+    printf("%-28s bytes=%-7d scew_us=%-9.1f stream_us=%-9.1f parts_us=%-9.1f speedup=%.1fx\n",
+           name, len, scew_us, stream_us, parts_us, scew_us / stream_us);
+    fflush(stdout);
+
+    return 0;
+}
+
+
+int main(int argc, char *argv[])
+{
+    int iterations = (argc > 1) ? atoi(argv[1]) : 2000;
+    int result = 0;
+    int i = 0;
+
+    if (iterations <= 0) {
+        fprintf(stderr, "Usage: %s [iterations] [message file]...\n", argv[0]);
+        return 1;
+    }
+
+#ifdef __GLIBC__
+    // Results are big (3 KB per triple), glibc returns them to the system
+    // after each message and page faults hide the time of parsing.
+    mallopt(M_TRIM_THRESHOLD, 64 * 1024 * 1024);
+#endif
+
+    for (i = 0; result == 0; ++i) {
+        char path[1024];
+        const char *name = NULL;
+
+        if (argc > 2) {
+            if (i + 2 >= argc) {
+                break;
+            }
+
+            name = argv[i + 2];
+            snprintf(path, sizeof(path), "%s", name);
+        } else {
+            if (g_default_messages[i] == NULL) {
+                break;
+            }
+
+            name = g_default_messages[i];
+            snprintf(path, sizeof(path), "%s/%s", SSAP_PARSE_MESSAGES_DIR, name);
+        }
+
+        int len = 0;
+        char *xml = load_file(path, &len);
+
+        if (xml == NULL) {
+            fprintf(stderr, "Can't read %s\n", path);
+            return 1;
+        }
+
+        result = run_message(name, xml, len, iterations);
+
+        free(xml);
+    }
+
+    return (result == 0) ? 0 : 1;
+}
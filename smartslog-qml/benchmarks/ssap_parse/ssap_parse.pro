@@ -0,0 +1,13 @@
+TEMPLATE = app
+TARGET = ssap_parse
+
+CONFIG += console
+CONFIG -= app_bundle qt
+
+include(../../vendor/SmartSlog/smartslog.pri)
+
+DEFINES += SSAP_PARSE_MESSAGES_DIR=\\\"$$PWD/messages\\\"
+
+SOURCES += \
+    ssap_parse.c \
+    parse_ssap_msg_scew.c
@@ -0,0 +1,1059 @@
+/**
+ * @file   suite.c
+ * @brief  Benchmark suite of the library with the mock SIB and a JSON report.
+ *
+ *
+ * @section LICENSE
+ *
+ * SmartSlog KP Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SmartSlog KP Library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SmartSlog KP Library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * Groups of benchmarks:
+ * - ssap: INSERT, QUERY, UPDATE, REMOVE and SPARQL SELECT of 1, 10, 100
+ *   and 1000 triples by a node (round trips to the mock SIB);
+ * - sbcr: an update of a triple by a publisher node is delivered to 1, 10
+ *   and 100 asynchronous subscriptions: latency of each delivery and of the
+ *   last one (fan-out);
+ * - burst: bursts of 100 and 2000 indications to an asynchronous subscription
+ *   with coalesce windows of 0 (each indication), 1 and 10 ms: time until
+ *   the last changed handler call and count of handler calls per burst;
+ * - pipeline: throughput of inserts of one triple by synchronous operations,
+ *   by asynchronous operations with 1, 4, 16 and 64 operations in flight and
+ *   of property inserts with batch windows of 0 (synchronous), 1 and 10 ms
+ *   (run it with the latency, for example -l 1000);
+ * - parse: parsing of QUERY confirmations with 1, 10, 100 and 1000 triples;
+ * - store: lookups in the local store with 1000, 10000 and 100000 triples
+ *   (each sample is a batch of lookups).
+ *
+ * Usage: suite [-o report.json] [-n iterations] [-l latency_us] [-p payload]
+ *              [-g group,...]
+ * By default 100 iterations without latency, objects of 64 bytes, all groups,
+ * the report is written to stdout.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "smartslog.h"
+#include "triplestore.h"
+#include <ckpi/ckpi.h>
+#include <ckpi/parse_ssap_msg.h>
+
+#include "bench_report.h"
+#include "mock_sib.h"
+
+
+#define BENCH_SPACE_ID "X"
+#define BENCH_NAMESPACE "http://smartslog/bench#"
+#define BENCH_PREDICATE BENCH_NAMESPACE "value"
+#define BENCH_GROUPS "ssap,sbcr,burst,pipeline,parse,store"
+
+/** @brief Maximum length of objects (SS_OBJECT_MAX_LEN of CKPI). */
+#define BENCH_PAYLOAD_MAX 1000
+
+/** @brief Lookups in one sample of the store group. */
+#define BENCH_STORE_BATCH 100
+
+/** @brief Maximum time to wait indications of one update, seconds. */
+#define BENCH_WAIT_TIMEOUT 120
+
+/** @brief Operations in one sample of the pipeline group. */
+#define BENCH_PIPELINE_OPERATIONS 100
+
+/** @brief Maximum bursts of one size in the burst group (each burst is a sample). */
+#define BENCH_BURST_ROUNDS 10
+
+
+/** @brief Options of the run. */
+static struct {
+    const char *report_path;
+    int iterations;
+    int latency_us;
+    int payload;
+    const char *groups;
+} g_options = {NULL, 100, 0, 64, BENCH_GROUPS};
+
+/** @brief Deliveries of the current update to subscriptions. */
+static struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int expected;
+    int received;
+    double sent_at;
+    double last_at;
+    bench_samples_t *samples;
+} g_fanout = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, 0, 0, 0, NULL};
+
+/** @brief Changed handler calls of the current burst of indications. */
+static struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int expected;               /**< Inserted triples of the burst. */
+    int received;
+    int calls;
+    double last_at;
+} g_burst = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, 0, 0, 0};
+
+
+/** @brief Makes an object of the payload size that starts with the number. */
+static void make_object(char *object, int number)
+{
+    static const char pattern[] = "payload ";
+    int length = snprintf(object, BENCH_PAYLOAD_MAX + 1, "%d ", number);
+    int i = 0;
+
+    for (i = length; i < g_options.payload; ++i) {
+        object[i] = pattern[i % (sizeof(pattern) - 1)];
+    }
+
+    object[(length > g_options.payload) ? length : g_options.payload] = '\0';
+}
+
+
+/** @brief Makes detached triples with numbered subjects. */
+static list_t *new_triples(const char *predicate, int round, int count, int version)
+{
+    list_t *triples = list_new();
+    char subject[128];
+    char object[BENCH_PAYLOAD_MAX + 1];
+    int i = 0;
+
+    make_object(object, version);
+
+    for (i = 0; i < count; ++i) {
+        snprintf(subject, sizeof(subject), BENCH_NAMESPACE "ssap%d_%d_%d", count, round, i);
+        list_add_data(triples, sslog_new_triple_detached(subject, predicate, object,
+                                                         SSLOG_RDF_TYPE_URI, SSLOG_RDF_TYPE_LIT));
+    }
+
+    return triples;
+}
+
+
+static bool is_group(const char *group)
+{
+    const char *found = strstr(g_options.groups, group);
+    int length = (int) strlen(group);
+
+    return (found != NULL && (found == g_options.groups || found[-1] == ',')
+            && (found[length] == '\0' || found[length] == ','));
+}
+
+
+/**
+ * @brief Runs the ssap group: operations of a node with the smart space.
+ * @return 0 on success or -1 otherwise.
+ */
+static int run_ssap(bench_report_t *report, sslog_node_t *node)
+{
+    static const int counts[] = {1, 10, 100, 1000};
+    char predicate[128];
+    char query[256];
+    int result = 0;
+    int k = 0;
+    int i = 0;
+
+    for (k = 0; k < (int) (sizeof(counts) / sizeof(counts[0])) && result == 0; ++k) {
+        int count = counts[k];
+        bench_samples_t insert_samples;
+        bench_samples_t query_samples;
+        bench_samples_t select_samples;
+        bench_samples_t update_samples;
+        bench_samples_t remove_samples;
+
+        bench_samples_init(&insert_samples);
+        bench_samples_init(&query_samples);
+        bench_samples_init(&select_samples);
+        bench_samples_init(&update_samples);
+        bench_samples_init(&remove_samples);
+
+        // Each count has own predicate, so queries find only triples of the round.
+        snprintf(predicate, sizeof(predicate), BENCH_NAMESPACE "ssap%d", count);
+        snprintf(query, sizeof(query), "SELECT ?s ?o WHERE { ?s <%s> ?o }", predicate);
+
+        sslog_triple_t *triple_template = sslog_new_triple_detached(SSLOG_TRIPLE_ANY, predicate, SSLOG_TRIPLE_ANY,
+                                                                    SSLOG_RDF_TYPE_URI, SSLOG_RDF_TYPE_URI);
+
+        for (i = 0; i < g_options.iterations && result == 0; ++i) {
+            list_t *triples = new_triples(predicate, i, count, 0);
+            list_t *new_values = new_triples(predicate, i, count, 1);
+            list_t *templates = list_new();
+
+            list_add_data(templates, triple_template);
+
+            double started = bench_now_us();
+            result = sslog_node_insert_triples(node, triples);
+            bench_samples_add(&insert_samples, bench_now_us() - started);
+
+            if (result == SSLOG_ERROR_NO) {
+                started = bench_now_us();
+                list_t *found = sslog_node_query_triple(node, triple_template);
+                bench_samples_add(&query_samples, bench_now_us() - started);
+
+                if (found == NULL || list_count(found) != count) {
+                    fprintf(stderr, "ssap: query returned %d triples of %d\n",
+                            (found != NULL) ? list_count(found) : -1, count);
+                    result = -1;
+                }
+
+                list_free_with_nodes(found, NULL);
+            }
+
+            if (result == SSLOG_ERROR_NO) {
+                started = bench_now_us();
+                sslog_sparql_result_t *rows = sslog_node_sparql_select(node, query, NULL);
+                bench_samples_add(&select_samples, bench_now_us() - started);
+
+                if (rows == NULL || rows->rows_count != count) {
+                    fprintf(stderr, "ssap: SPARQL SELECT returned %d rows of %d\n",
+                            (rows != NULL) ? rows->rows_count : -1, count);
+                    result = -1;
+                }
+
+                sslog_free_sparql_result(rows);
+            }
+
+            // Stored triples are unstored by the update and removed triples are freed by the store.
+            if (result == SSLOG_ERROR_NO) {
+                started = bench_now_us();
+                result = sslog_node_update_triples(node, triples, new_values);
+                bench_samples_add(&update_samples, bench_now_us() - started);
+            }
+
+            if (result == SSLOG_ERROR_NO) {
+                started = bench_now_us();
+                result = sslog_node_remove_triples(node, templates);
+                bench_samples_add(&remove_samples, bench_now_us() - started);
+
+                list_free_with_nodes(new_values, NULL);
+                new_values = NULL;
+            }
+
+            if (result != SSLOG_ERROR_NO && result != -1) {
+                fprintf(stderr, "ssap: %s\n", sslog_error_get_last_text());
+            }
+
+            sslog_free_triples(triples);
+
+            if (new_values != NULL) {
+                sslog_free_triples(new_values);
+            }
+
+            list_free_with_nodes(templates, NULL);
+        }
+
+        sslog_free_triple(triple_template);
+
+        if (result == 0) {
+            bench_report_add(report, "ssap", "insert", &insert_samples, "triples", count, "\"triples\": %d", count);
+            bench_report_add(report, "ssap", "query", &query_samples, "triples", count, "\"triples\": %d", count);
+            bench_report_add(report, "ssap", "sparql_select", &select_samples, "triples", count, "\"triples\": %d", count);
+            bench_report_add(report, "ssap", "update", &update_samples, "triples", count, "\"triples\": %d", count);
+            bench_report_add(report, "ssap", "remove", &remove_samples, "triples", count, "\"triples\": %d", count);
+        }
+
+        bench_samples_free(&insert_samples);
+        bench_samples_free(&query_samples);
+        bench_samples_free(&select_samples);
+        bench_samples_free(&update_samples);
+        bench_samples_free(&remove_samples);
+    }
+
+    return (result == 0) ? 0 : -1;
+}
+
+
+static void on_delivered(sslog_subscription_t *subscription)
+{
+    double now = bench_now_us();
+
+    (void) subscription;
+
+    pthread_mutex_lock(&g_fanout.mutex);
+
+    if (g_fanout.received < g_fanout.expected) {
+        bench_samples_add(g_fanout.samples, now - g_fanout.sent_at);
+        g_fanout.last_at = now;
+
+        if (++g_fanout.received == g_fanout.expected) {
+            pthread_cond_signal(&g_fanout.cond);
+        }
+    }
+
+    pthread_mutex_unlock(&g_fanout.mutex);
+}
+
+
+/**
+ * @brief Runs the sbcr group: delivery of updates to subscriptions.
+ *
+ * The publisher has own session, so its local store is not shared with
+ * the store that is updated by indications.
+ *
+ * @return 0 on success or -1 otherwise.
+ */
+static int run_sbcr(bench_report_t *report, sslog_node_t *node, sslog_node_t *publisher)
+{
+    static const int counts[] = {1, 10, 100};
+    char subject[128];
+    char object[BENCH_PAYLOAD_MAX + 1];
+    int result = 0;
+    int k = 0;
+    int i = 0;
+
+    for (k = 0; k < (int) (sizeof(counts) / sizeof(counts[0])) && result == 0; ++k) {
+        int count = counts[k];
+        sslog_subscription_t **subscriptions = (sslog_subscription_t **)
+                calloc(count, sizeof(sslog_subscription_t *));
+        bench_samples_t delivery_samples;
+        bench_samples_t fanout_samples;
+
+        bench_samples_init(&delivery_samples);
+        bench_samples_init(&fanout_samples);
+
+        snprintf(subject, sizeof(subject), BENCH_NAMESPACE "sbcr%d", count);
+
+        sslog_triple_t *triple_template = sslog_new_triple_detached(subject, BENCH_PREDICATE, SSLOG_TRIPLE_ANY,
+                                                                    SSLOG_RDF_TYPE_URI, SSLOG_RDF_TYPE_URI);
+
+        for (i = 0; i < count; ++i) {
+            subscriptions[i] = sslog_new_subscription(node, true);
+            sslog_sbcr_add_triple_template(subscriptions[i], triple_template);
+            sslog_sbcr_set_changed_handler(subscriptions[i], on_delivered);
+
+            if (sslog_sbcr_subscribe(subscriptions[i]) != SSLOG_ERROR_NO) {
+                fprintf(stderr, "sbcr: can't subscribe: %s\n", sslog_error_get_last_text());
+                count = i + 1;
+                result = -1;
+                break;
+            }
+        }
+
+        for (i = 0; i < g_options.iterations && result == 0; ++i) {
+            make_object(object, i);
+            sslog_triple_t *current = sslog_new_triple_detached(subject, BENCH_PREDICATE, SSLOG_TRIPLE_ANY,
+                                                                SSLOG_RDF_TYPE_URI, SSLOG_RDF_TYPE_URI);
+            sslog_triple_t *new_triple = sslog_new_triple_detached(subject, BENCH_PREDICATE, object,
+                                                                   SSLOG_RDF_TYPE_URI, SSLOG_RDF_TYPE_LIT);
+
+            pthread_mutex_lock(&g_fanout.mutex);
+            g_fanout.expected = count;
+            g_fanout.received = 0;
+            g_fanout.samples = &delivery_samples;
+            g_fanout.sent_at = bench_now_us();
+            pthread_mutex_unlock(&g_fanout.mutex);
+
+            result = sslog_node_update_triple(publisher, current, new_triple);
+
+            // The new triple is stored by the publisher, the template is not.
+            sslog_free_triple(current);
+            sslog_free_triple(new_triple);
+
+            if (result != SSLOG_ERROR_NO) {
+                fprintf(stderr, "sbcr: can't update: %s\n", sslog_error_get_last_text());
+                break;
+            }
+
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_sec += BENCH_WAIT_TIMEOUT;
+
+            pthread_mutex_lock(&g_fanout.mutex);
+
+            while (g_fanout.received < g_fanout.expected) {
+                if (pthread_cond_timedwait(&g_fanout.cond, &g_fanout.mutex, &deadline) != 0) {
+                    break;
+                }
+            }
+
+            if (g_fanout.received == g_fanout.expected) {
+                bench_samples_add(&fanout_samples, g_fanout.last_at - g_fanout.sent_at);
+            } else {
+                fprintf(stderr, "sbcr: %d of %d indications are received\n", g_fanout.received, g_fanout.expected);
+                result = -1;
+            }
+
+            g_fanout.expected = 0;
+            g_fanout.samples = NULL;
+
+            pthread_mutex_unlock(&g_fanout.mutex);
+        }
+
+        if (result == 0) {
+            bench_report_add(report, "sbcr", "delivery", &delivery_samples, "indications", 1,
+                             "\"subscriptions\": %d", count);
+            bench_report_add(report, "sbcr", "fanout", &fanout_samples, "indications", count,
+                             "\"subscriptions\": %d", count);
+        }
+
+        for (i = 0; i < count; ++i) {
+            if (subscriptions[i] != NULL) {
+                sslog_sbcr_unsubscribe(subscriptions[i]);
+                sslog_free_subscription(subscriptions[i]);
+            }
+        }
+
+        sslog_node_remove_triple(publisher, triple_template);
+        sslog_free_triple(triple_template);
+
+        bench_samples_free(&delivery_samples);
+        bench_samples_free(&fanout_samples);
+        free(subscriptions);
+    }
+
+    return result;
+}
+
+
+static void on_burst_changed(sslog_subscription_t *subscription)
+{
+    double now = bench_now_us();
+    list_t *inserted = sslog_sbcr_ch_get_triples(sslog_sbcr_get_changes_last(subscription), SSLOG_ACTION_INSERT);
+    int count = (inserted != NULL) ? list_count(inserted) : 0;
+
+    list_free_with_nodes(inserted, NULL);
+
+    pthread_mutex_lock(&g_burst.mutex);
+
+    g_burst.received += count;
+    g_burst.last_at = now;
+    ++g_burst.calls;
+
+    if (g_burst.received >= g_burst.expected) {
+        pthread_cond_signal(&g_burst.cond);
+    }
+
+    pthread_mutex_unlock(&g_burst.mutex);
+}
+
+
+/**
+ * @brief Runs the burst group: bursts of indications with coalesce windows.
+ *
+ * The mock SIB sends all indications of a burst at once, each one inserts
+ * a triple with other object. A sample is the time from the start of
+ * sending to the last call of the changed handler, all triples of the burst
+ * are reported by the handler by this time.
+ *
+ * @return 0 on success or -1 otherwise.
+ */
+static int run_burst(bench_report_t *report, sslog_node_t *node, mock_sib_t *sib)
+{
+    static const int sizes[] = {100, 2000};
+    static const int windows[] = {0, 1, 10};
+    int rounds = (g_options.iterations < BENCH_BURST_ROUNDS) ? g_options.iterations : BENCH_BURST_ROUNDS;
+    char subject[128];
+    char object[BENCH_PAYLOAD_MAX + 1];
+    int result = 0;
+    int w = 0;
+    int k = 0;
+    int i = 0;
+    int j = 0;
+
+    for (w = 0; w < (int) (sizeof(windows) / sizeof(windows[0])) && result == 0; ++w) {
+        snprintf(subject, sizeof(subject), BENCH_NAMESPACE "burst%d", windows[w]);
+
+        sslog_triple_t *triple_template = sslog_new_triple_detached(subject, BENCH_PREDICATE, SSLOG_TRIPLE_ANY,
+                                                                    SSLOG_RDF_TYPE_URI, SSLOG_RDF_TYPE_URI);
+        sslog_subscription_t *subscription = sslog_new_subscription(node, true);
+        int number = mock_sib_subscriptions_count(sib);
+
+        sslog_sbcr_add_triple_template(subscription, triple_template);
+        sslog_sbcr_set_changed_handler(subscription, on_burst_changed);
+        sslog_sbcr_set_coalesce_window(subscription, windows[w]);
+
+        if (sslog_sbcr_subscribe(subscription) != SSLOG_ERROR_NO) {
+            fprintf(stderr, "burst: can't subscribe: %s\n", sslog_error_get_last_text());
+            result = -1;
+        }
+
+        for (k = 0; k < (int) (sizeof(sizes) / sizeof(sizes[0])) && result == 0; ++k) {
+            int size = sizes[k];
+            int calls = 0;
+            bench_samples_t samples;
+
+            bench_samples_init(&samples);
+
+            for (i = 0; i < rounds && result == 0; ++i) {
+                pthread_mutex_lock(&g_burst.mutex);
+                g_burst.expected = size;
+                g_burst.received = 0;
+                g_burst.calls = 0;
+                pthread_mutex_unlock(&g_burst.mutex);
+
+                double started = bench_now_us();
+
+                for (j = 0; j < size && result == 0; ++j) {
+                    make_object(object, j);
+                    result = mock_sib_indicate(sib, number, subject, BENCH_PREDICATE, object);
+                }
+
+                struct timespec deadline;
+                clock_gettime(CLOCK_REALTIME, &deadline);
+                deadline.tv_sec += BENCH_WAIT_TIMEOUT;
+
+                pthread_mutex_lock(&g_burst.mutex);
+
+                while (result == 0 && g_burst.received < g_burst.expected) {
+                    if (pthread_cond_timedwait(&g_burst.cond, &g_burst.mutex, &deadline) != 0) {
+                        break;
+                    }
+                }
+
+                if (result == 0 && g_burst.received == g_burst.expected) {
+                    bench_samples_add(&samples, g_burst.last_at - started);
+                    calls += g_burst.calls;
+                } else {
+                    fprintf(stderr, "burst: %d of %d triples are received\n", g_burst.received, g_burst.expected);
+                    result = -1;
+                }
+
+                g_burst.expected = 0;
+
+                pthread_mutex_unlock(&g_burst.mutex);
+
+                // Triples of the burst are removed from the local store, the mock SIB does not have them.
+                if (result == 0 && sslog_node_remove_triple(node, triple_template) != SSLOG_ERROR_NO) {
+                    fprintf(stderr, "burst: can't remove: %s\n", sslog_error_get_last_text());
+                    result = -1;
+                }
+            }
+
+            if (result == 0) {
+                bench_report_add(report, "burst", "indications", &samples, "indications", size,
+                                 "\"indications\": %d, \"window_ms\": %d, \"handler_calls\": %.1f",
+                                 size, windows[w], (double) calls / rounds);
+            }
+
+            bench_samples_free(&samples);
+        }
+
+        sslog_sbcr_unsubscribe(subscription);
+        sslog_free_subscription(subscription);
+        sslog_free_triple(triple_template);
+    }
+
+    return result;
+}
+
+
+static void on_confirmed(sslog_node_t *node, int sslog_errno, list_t *triples, void *user_data)
+{
+    (void) node;
+    (void) triples;
+
+    if (sslog_errno != SSLOG_ERROR_NO) {
+        ++*((int *) user_data);
+    }
+}
+
+
+/** @brief Makes a triple of the pipeline group. */
+static sslog_triple_t *new_pipeline_triple(const char *predicate, int number)
+{
+    char subject[128];
+    char object[BENCH_PAYLOAD_MAX + 1];
+
+    snprintf(subject, sizeof(subject), BENCH_NAMESPACE "pipeline%d", number);
+    make_object(object, number);
+
+    return sslog_new_triple_detached(subject, predicate, object, SSLOG_RDF_TYPE_URI, SSLOG_RDF_TYPE_LIT);
+}
+
+
+/**
+ * @brief Runs the pipeline group: throughput of operations that do not wait
+ * for confirmations against synchronous ones.
+ *
+ * Each sample is #BENCH_PIPELINE_OPERATIONS operations, inserted triples are
+ * removed after each sample.
+ *
+ * @return 0 on success or -1 otherwise.
+ */
+static int run_pipeline(bench_report_t *report, sslog_node_t *node)
+{
+    static const int depths[] = {1, 4, 16, 64};
+    static const int windows[] = {0, 1, 10};
+    const int timeout = BENCH_WAIT_TIMEOUT * 1000;
+    const char *predicate = BENCH_NAMESPACE "pipeline";
+    char object[BENCH_PAYLOAD_MAX + 1];
+    bench_samples_t samples;
+    int errors = 0;
+    int result = 0;
+    int k = 0;
+    int i = 0;
+    int j = 0;
+
+    sslog_triple_t *triple_template = sslog_new_triple_detached(SSLOG_TRIPLE_ANY, predicate, SSLOG_TRIPLE_ANY,
+                                                                SSLOG_RDF_TYPE_URI, SSLOG_RDF_TYPE_URI);
+
+    // Synchronous inserts: a round trip for each operation.
+    bench_samples_init(&samples);
+
+    for (i = 0; i < g_options.iterations && result == 0; ++i) {
+        double started = bench_now_us();
+
+        for (j = 0; j < BENCH_PIPELINE_OPERATIONS && result == 0; ++j) {
+            sslog_triple_t *triple = new_pipeline_triple(predicate, j);
+            result = sslog_node_insert_triple(node, triple);
+
+            if (result != SSLOG_ERROR_NO) {
+                sslog_free_triple(triple);
+            }
+        }
+
+        bench_samples_add(&samples, bench_now_us() - started);
+
+        if (result == SSLOG_ERROR_NO) {
+            result = sslog_node_remove_triple(node, triple_template);
+        }
+    }
+
+    if (result == 0) {
+        bench_report_add(report, "pipeline", "insert_sync", &samples, "operations", BENCH_PIPELINE_OPERATIONS,
+                         "\"depth\": %d", 1);
+    }
+
+    bench_samples_free(&samples);
+
+    // Asynchronous inserts: confirmations are processed when the pipeline is full.
+    for (k = 0; k < (int) (sizeof(depths) / sizeof(depths[0])) && result == 0; ++k) {
+        int depth = depths[k];
+
+        bench_samples_init(&samples);
+
+        for (i = 0; i < g_options.iterations && result == 0; ++i) {
+            double started = bench_now_us();
+
+            for (j = 0; j < BENCH_PIPELINE_OPERATIONS && result == 0; ++j) {
+                while (result == 0 && sslog_node_get_transactions_count(node) >= depth) {
+                    if (sslog_node_process_transactions(node, timeout) < 0) {
+                        result = -1;
+                    }
+                }
+
+                if (result == 0) {
+                    // Triples are copied by the operation.
+                    list_t *triples = list_new();
+                    list_add_data(triples, new_pipeline_triple(predicate, j));
+
+                    result = sslog_node_insert_triples_async(node, triples, on_confirmed, &errors);
+
+                    sslog_free_triples(triples);
+                }
+            }
+
+            if (result == 0) {
+                result = sslog_node_wait_transactions(node, timeout);
+            }
+
+            bench_samples_add(&samples, bench_now_us() - started);
+
+            if (result == SSLOG_ERROR_NO) {
+                result = sslog_node_remove_triple(node, triple_template);
+            }
+        }
+
+        if (result == 0 && errors == 0) {
+            bench_report_add(report, "pipeline", "insert_async", &samples, "operations", BENCH_PIPELINE_OPERATIONS,
+                             "\"depth\": %d", depth);
+        }
+
+        bench_samples_free(&samples);
+    }
+
+    // Property inserts: collected changes are sent without waiting by one operation.
+    sslog_class_t *bench_class = sslog_new_class(BENCH_NAMESPACE "Pipeline");
+    sslog_individual_t *individual = sslog_new_individual(bench_class, BENCH_NAMESPACE "pipeline_individual");
+    sslog_property_t *property = sslog_new_property(BENCH_NAMESPACE "pipelineValue", SSLOG_PROPERTY_TYPE_DATA);
+
+    if (individual == NULL || property == NULL) {
+        result = -1;
+    }
+
+    for (k = 0; k < (int) (sizeof(windows) / sizeof(windows[0])) && result == 0; ++k) {
+        int window = windows[k];
+
+        bench_samples_init(&samples);
+
+        for (i = 0; i < g_options.iterations && result == 0; ++i) {
+            sslog_node_set_batch_window(node, window);
+
+            double started = bench_now_us();
+
+            for (j = 0; j < BENCH_PIPELINE_OPERATIONS && result == 0; ++j) {
+                make_object(object, j);
+                result = sslog_node_insert_property(node, individual, property, object);
+            }
+
+            if (result == 0) {
+                result = sslog_node_wait_transactions(node, timeout);
+            }
+
+            bench_samples_add(&samples, bench_now_us() - started);
+
+            sslog_node_set_batch_window(node, 0);
+
+            if (result == SSLOG_ERROR_NO) {
+                result = sslog_node_remove_property(node, individual, property, NULL);
+            }
+        }
+
+        if (result == 0) {
+            bench_report_add(report, "pipeline", "insert_property", &samples, "operations", BENCH_PIPELINE_OPERATIONS,
+                             "\"window_ms\": %d", window);
+        }
+
+        bench_samples_free(&samples);
+    }
+
+    if (result != 0 || errors > 0) {
+        fprintf(stderr, "pipeline: %s (%d operations failed)\n", sslog_error_get_last_text(), errors);
+        result = -1;
+    }
+
+    sslog_free_triple(triple_template);
+
+    return result;
+}
+
+
+static void free_msg(ssap_msg_t *msg)
+{
+    ss_delete_triples(msg->n_result);
+    ss_delete_triples(msg->o_result);
+    ss_delete_sparql_results(msg->n_sparql_select_result, msg->number_of_bindings);
+    ss_delete_sparql_results(msg->o_sparql_select_result, msg->number_of_bindings);
+
+    while (msg->bnodes != NULL) {
+        bnode_tmp_t *bnode = msg->bnodes;
+        msg->bnodes = bnode->next;
+        free(bnode);
+    }
+}
+
+
+/** @brief Makes a QUERY confirmation with given count of triples. */
+static char *new_query_confirm(int count, int *len)
+{
+    static const char head[] =
+            "<SSAP_message><transaction_type>QUERY</transaction_type>"
+            "<message_type>CONFIRM</message_type><transaction_id>1</transaction_id>"
+            "<node_id>suite</node_id><space_id>" BENCH_SPACE_ID "</space_id>"
+            "<parameter name=\"status\">m3:Success</parameter>"
+            "<parameter name=\"results\"><triple_list>";
+    static const char tail[] = "</triple_list></parameter></SSAP_message>";
+    static const char triple_format[] =
+            "<triple><subject type=\"uri\">" BENCH_NAMESPACE "parse%d</subject>"
+            "<predicate>" BENCH_PREDICATE "</predicate>"
+            "<object type=\"literal\">%s</object></triple>";
+    int capacity = (int) (sizeof(head) + sizeof(tail))
+            + count * (int) (sizeof(triple_format) + 16 + BENCH_PAYLOAD_MAX);
+    char *xml = (char *) malloc(capacity);
+    char object[BENCH_PAYLOAD_MAX + 1];
+    int i = 0;
+
+    if (xml == NULL) {
+        return NULL;
+    }
+
+    *len = snprintf(xml, capacity, "%s", head);
+
+    for (i = 0; i < count; ++i) {
+        make_object(object, i);
+        *len += snprintf(xml + *len, capacity - *len, triple_format, i, object);
+    }
+
+    *len += snprintf(xml + *len, capacity - *len, "%s", tail);
+
+    return xml;
+}
+
+
+/**
+ * @brief Runs the parse group: parsing of confirmations by size.
+ * @return 0 on success or -1 otherwise.
+ */
+static int run_parse(bench_report_t *report)
+{
+    static const int counts[] = {1, 10, 100, 1000};
+    int k = 0;
+    int i = 0;
+
+    for (k = 0; k < (int) (sizeof(counts) / sizeof(counts[0])); ++k) {
+        int count = counts[k];
+        int len = 0;
+        char *xml = new_query_confirm(count, &len);
+        bench_samples_t samples;
+        ssap_msg_t msg;
+
+        if (xml == NULL) {
+            return -1;
+        }
+
+        memset(&msg, 0, sizeof(msg));
+
+        // Warm up and check the message.
+        if (parse_ssap_msg(xml, len, &msg) != 0 || msg.n_result == NULL) {
+            fprintf(stderr, "parse: can't parse the message with %d triples\n", count);
+            free_msg(&msg);
+            free(xml);
+            return -1;
+        }
+
+        free_msg(&msg);
+
+        bench_samples_init(&samples);
+
+        for (i = 0; i < g_options.iterations; ++i) {
+            double started = bench_now_us();
+
+            memset(&msg, 0, sizeof(msg));
+            parse_ssap_msg(xml, len, &msg);
+            free_msg(&msg);
+
+            bench_samples_add(&samples, bench_now_us() - started);
+        }
+
+        bench_report_add(report, "parse", "query_confirm", &samples, "bytes", len,
+                         "\"triples\": %d, \"bytes\": %d", count, len);
+
+        bench_samples_free(&samples);
+        free(xml);
+    }
+
+    return 0;
+}
+
+
+/**
+ * @brief Runs the store group: lookups in the local store by size.
+ * @return 0 on success or -1 otherwise.
+ */
+static int run_store(bench_report_t *report)
+{
+    static const int counts[] = {1000, 10000, 100000};
+    char subject[128];
+    char object[BENCH_PAYLOAD_MAX + 1];
+    unsigned int seed = 1;
+    int k = 0;
+    int i = 0;
+    int j = 0;
+
+    make_object(object, 0);
+
+    for (k = 0; k < (int) (sizeof(counts) / sizeof(counts[0])); ++k) {
+        int count = counts[k];
+        sslog_store_t *store = sslog_store_new();
+        bench_samples_t add_samples;
+        bench_samples_t query_samples;
+        bench_samples_t exists_samples;
+        int found = 0;
+
+        if (store == NULL) {
+            return -1;
+        }
+
+        bench_samples_init(&add_samples);
+        bench_samples_init(&query_samples);
+        bench_samples_init(&exists_samples);
+
+        for (i = 0; i < count; i += BENCH_STORE_BATCH) {
+            double started = bench_now_us();
+
+            for (j = i; j < i + BENCH_STORE_BATCH && j < count; ++j) {
+                snprintf(subject, sizeof(subject), BENCH_NAMESPACE "store%d", j);
+                sslog_store_add_triple(store, sslog_new_triple_detached(subject, BENCH_PREDICATE, object,
+                                                                        SSLOG_RDF_TYPE_URI, SSLOG_RDF_TYPE_LIT));
+            }
+
+            bench_samples_add(&add_samples, bench_now_us() - started);
+        }
+
+        for (i = 0; i < g_options.iterations; ++i) {
+            double started = bench_now_us();
+
+            for (j = 0; j < BENCH_STORE_BATCH; ++j) {
+                seed = seed * 1103515245u + 12345u;
+                snprintf(subject, sizeof(subject), BENCH_NAMESPACE "store%u", (seed >> 8) % count);
+
+                list_t *triples = sslog_store_query_triples_by_data(store, subject, BENCH_PREDICATE, SSLOG_TRIPLE_ANY,
+                                                                    SSLOG_RDF_TYPE_URI, SSLOG_RDF_TYPE_LIT, -1);
+                found += list_count(triples);
+                list_free_with_nodes(triples, NULL);
+            }
+
+            bench_samples_add(&query_samples, bench_now_us() - started);
+
+            started = bench_now_us();
+
+            for (j = 0; j < BENCH_STORE_BATCH; ++j) {
+                seed = seed * 1103515245u + 12345u;
+                snprintf(subject, sizeof(subject), BENCH_NAMESPACE "store%u", (seed >> 8) % count);
+
+                if (sslog_store_exists_template_data(store, subject, BENCH_PREDICATE, object,
+                                                     SSLOG_RDF_TYPE_URI, SSLOG_RDF_TYPE_LIT) == true) {
+                    ++found;
+                }
+            }
+
+            bench_samples_add(&exists_samples, bench_now_us() - started);
+        }
+
+        if (sslog_store_count(store) != count || found != 2 * BENCH_STORE_BATCH * g_options.iterations) {
+            fprintf(stderr, "store: %d of %d lookups found triples\n",
+                    found, 2 * BENCH_STORE_BATCH * g_options.iterations);
+            sslog_store_free(store);
+            return -1;
+        }
+
+        bench_report_add(report, "store", "add", &add_samples, "triples", BENCH_STORE_BATCH,
+                         "\"triples\": %d, \"batch\": %d", count, BENCH_STORE_BATCH);
+        bench_report_add(report, "store", "query_subject", &query_samples, "lookups", BENCH_STORE_BATCH,
+                         "\"triples\": %d, \"batch\": %d", count, BENCH_STORE_BATCH);
+        bench_report_add(report, "store", "exists", &exists_samples, "lookups", BENCH_STORE_BATCH,
+                         "\"triples\": %d, \"batch\": %d", count, BENCH_STORE_BATCH);
+
+        bench_samples_free(&add_samples);
+        bench_samples_free(&query_samples);
+        bench_samples_free(&exists_samples);
+        sslog_store_free(store);
+    }
+
+    return 0;
+}
+
+
+static void print_usage(const char *name)
+{
+    fprintf(stderr, "Usage: %s [-o report.json] [-n iterations] [-l latency_us] [-p payload] [-g group,...]\n"
+            "Groups: " BENCH_GROUPS "\n", name);
+}
+
+
+int main(int argc, char *argv[])
+{
+    int option = 0;
+    int result = 0;
+
+    while ((option = getopt(argc, argv, "o:n:l:p:g:h")) != -1) {
+        switch (option) {
+        case 'o':
+            g_options.report_path = optarg;
+            break;
+        case 'n':
+            g_options.iterations = atoi(optarg);
+            break;
+        case 'l':
+            g_options.latency_us = atoi(optarg);
+            break;
+        case 'p':
+            g_options.payload = atoi(optarg);
+            break;
+        case 'g':
+            g_options.groups = optarg;
+            break;
+        default:
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (optind < argc || g_options.iterations <= 0 || g_options.latency_us < 0
+            || g_options.payload < 0 || g_options.payload > BENCH_PAYLOAD_MAX) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    bench_report_t *report = bench_report_open(g_options.report_path);
+
+    if (report == NULL) {
+        return 1;
+    }
+
+    bench_report_set_config(report, "iterations", g_options.iterations);
+    bench_report_set_config(report, "latency_us", g_options.latency_us);
+    bench_report_set_config(report, "payload", g_options.payload);
+
+    if (is_group("ssap") == true || is_group("sbcr") == true || is_group("burst") == true
+            || is_group("pipeline") == true) {
+        mock_sib_t *sib = mock_sib_start(0);
+
+        if (sib == NULL) {
+            bench_report_close(report);
+            return 1;
+        }
+
+        mock_sib_set_latency(sib, g_options.latency_us);
+
+        sslog_init();
+
+        sslog_session_t *publisher_session = sslog_new_session();
+        sslog_node_t *node = sslog_new_node("suite", BENCH_SPACE_ID, "127.0.0.1", mock_sib_port(sib));
+        sslog_node_t *publisher = sslog_new_session_node(publisher_session, "suite_publisher", BENCH_SPACE_ID,
+                                                         "127.0.0.1", mock_sib_port(sib));
+
+        if (node == NULL || publisher == NULL
+                || sslog_node_join(node) != SSLOG_ERROR_NO
+                || sslog_node_join(publisher) != SSLOG_ERROR_NO) {
+            fprintf(stderr, "Can't join: %s\n", sslog_error_get_last_text());
+            result = -1;
+        }
+
+        if (result == 0 && is_group("ssap") == true) {
+            result = run_ssap(report, node);
+        }
+
+        if (result == 0 && is_group("sbcr") == true) {
+            result = run_sbcr(report, node, publisher);
+        }
+
+        if (result == 0 && is_group("burst") == true) {
+            result = run_burst(report, node, sib);
+        }
+
+        if (result == 0 && is_group("pipeline") == true) {
+            result = run_pipeline(report, node);
+        }
+
+        sslog_node_leave(publisher);
+        sslog_node_leave(node);
+        sslog_free_session(publisher_session);
+        sslog_shutdown();
+
+        mock_sib_stop(sib);
+    }
+
+    if (result == 0 && is_group("parse") == true) {
+        result = run_parse(report);
+    }
+
+    if (result == 0 && is_group("store") == true) {
+        result = run_store(report);
+    }
+
+    if (bench_report_close(report) != 0) {
+        result = -1;
+    }
+
+    return (result == 0) ? 0 : 1;
+}
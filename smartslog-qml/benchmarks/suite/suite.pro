@@ -0,0 +1,14 @@
+TEMPLATE = app
+TARGET = suite
+
+CONFIG += console
+CONFIG -= app_bundle qt
+
+include(../../vendor/SmartSlog/smartslog.pri)
+
+INCLUDEPATH += ../common
+
+SOURCES += \
+    suite.c \
+    ../common/bench_report.c \
+    ../common/mock_sib.c
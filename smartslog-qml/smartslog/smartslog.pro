@@ -0,0 +1,9 @@
+# SmartSlog KP library (static) for the application and benchmarks.
+
+TEMPLATE = lib
+TARGET = smartslog
+
+CONFIG += staticlib
+CONFIG -= qt
+
+include(../vendor/SmartSlog/smartslog.pri)
@@ -4,3 +4,5 @@ SUBDIRS = \
         smartslog \
         app/app.pro
 
+# Benchmarks use the mock SIB (epoll, timerfd).
+linux: SUBDIRS += benchmarks
@@ -32,8 +32,10 @@
 #include <QtQuick>
 #endif
 
+#include <QtQml>
 #include <sailfishapp.h>
 
+#include "GameEngine.h"
 
 
 int main(int argc, char *argv[])
@@ -48,6 +50,8 @@ int main(int argc, char *argv[])
     // To display the view, call "show()" (will show fullscreen on device).
     //QQmlEngine engine;
     //engine.addImportPath("qrc:///");
+    qmlRegisterType<GameEngine>("Game", 1, 0, "GameEngine");
+
     return SailfishApp::main(argc, argv);
 }
 
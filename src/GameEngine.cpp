@@ -0,0 +1,199 @@
+#include "GameEngine.h"
+#include "GameModels.h"
+
+GameEngine::GameEngine(QObject *parent)
+    : QObject(parent)
+    , m_entities(new EntityListModel(&m_world, this))
+    , m_particles(new ParticleListModel(&m_world, this))
+    , m_running(true)
+    , m_particleCount(0)
+    , m_winner(0)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, SIGNAL(timeout()), this, SLOT(tick()));
+
+    m_clock.start();
+    scheduleTick();
+}
+
+QAbstractItemModel *GameEngine::entities() const
+{
+    return m_entities;
+}
+
+QAbstractItemModel *GameEngine::particles() const
+{
+    return m_particles;
+}
+
+void GameEngine::setSceneWidth(qreal width)
+{
+    if (width == m_world.width())
+        return;
+
+    m_world.resize(width, m_world.height());
+    emit sceneSizeChanged();
+}
+
+void GameEngine::setSceneHeight(qreal height)
+{
+    if (height == m_world.height())
+        return;
+
+    m_world.resize(m_world.width(), height);
+    emit sceneSizeChanged();
+}
+
+void GameEngine::setRunning(bool running)
+{
+    if (running == m_running)
+        return;
+
+    m_running = running;
+
+    if (m_running) {
+        // Time of the pause is not simulated.
+        m_clock.restart();
+        scheduleTick();
+    } else {
+        catchUp();
+        m_timer.stop();
+    }
+
+    emit runningChanged();
+}
+
+int GameEngine::generate(qreal x, qreal y, int player, int score)
+{
+    int index = m_world.addEntity(x, y, player, score);
+
+    m_entities->entityAdded();
+    emit entityCountChanged();
+    applyChanges(GameWorld::NoChange);
+
+    return index;
+}
+
+int GameEngine::getPointed(const QPointF &position) const
+{
+    return m_world.entityAt(position.x(), position.y());
+}
+
+QPointF GameEngine::entityPosition(int index) const
+{
+    return isEntity(index) ? QPointF(m_world.entityX(index), m_world.entityY(index)) : QPointF();
+}
+
+int GameEngine::entityPlayer(int index) const
+{
+    return isEntity(index) ? m_world.entityPlayer(index) : 0;
+}
+
+int GameEngine::entityScore(int index) const
+{
+    return isEntity(index) ? m_world.entityScore(index) : 0;
+}
+
+int GameEngine::changeScore(const QPointF &startPosition)
+{
+    int index = -1;
+    int charge = 0;
+
+    catchUp();
+
+    index = m_world.entityAt(startPosition.x(), startPosition.y());
+    if (index < 0)
+        return 0;
+
+    charge = m_world.takeCharge(index);
+    applyChanges(GameWorld::EntitiesChanged);
+
+    return charge;
+}
+
+void GameEngine::createParticleObjects(qreal startX, qreal startY, qreal endX, qreal endY, int charge, int nextplayer)
+{
+    // The particle starts now, not at the last tick.
+    catchUp();
+
+    m_world.launchParticle(startX, startY, endX, endY, charge, nextplayer);
+    applyChanges(GameWorld::ParticlesChanged);
+    scheduleTick();
+}
+
+void GameEngine::addCharge(qreal finX, qreal finY, int charge, int nextplayer)
+{
+    catchUp();
+
+    if (m_world.addCharge(finX, finY, charge, nextplayer) >= 0)
+        applyChanges(GameWorld::EntitiesChanged);
+}
+
+bool GameEngine::checkWinner() const
+{
+    return m_world.winner() != 0;
+}
+
+void GameEngine::clear()
+{
+    m_world.clear();
+    m_entities->reset();
+    m_particles->reset();
+
+    emit entityCountChanged();
+    applyChanges(GameWorld::NoChange);
+    scheduleTick();
+}
+
+void GameEngine::tick()
+{
+    applyChanges(m_world.advance(int(m_clock.restart())));
+    scheduleTick();
+}
+
+void GameEngine::catchUp()
+{
+    if (m_running)
+        applyChanges(m_world.advance(int(m_clock.restart())));
+}
+
+void GameEngine::applyChanges(int changes)
+{
+    int winner = 0;
+
+    if (changes & GameWorld::EntitiesChanged)
+        m_entities->entitiesChanged();
+
+    if (changes & GameWorld::ParticlesChanged)
+        m_particles->particlesChanged();
+
+    if (m_particleCount != m_world.particleCount()) {
+        m_particleCount = m_world.particleCount();
+        emit particleCountChanged();
+    }
+
+    winner = m_world.winner();
+    if (winner != m_winner) {
+        m_winner = winner;
+        emit winnerChanged();
+    }
+}
+
+void GameEngine::scheduleTick()
+{
+    if (!m_running)
+        return;
+
+    // Without particles in flight only scores change, once per period,
+    // so the timer doesn't wake up for every frame.
+    if (m_world.particleCount() > 0)
+        m_timer.start(GameWorld::StepMs);
+    else
+        m_timer.start(m_world.msToNextScore());
+}
+
+bool GameEngine::isEntity(int index) const
+{
+    return index >= 0 && index < m_world.entityCount();
+}
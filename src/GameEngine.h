@@ -0,0 +1,86 @@
+#ifndef GAMEENGINE_H
+#define GAMEENGINE_H
+
+#include <QAbstractItemModel>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointF>
+#include <QTimer>
+
+#include "GameWorld.h"
+
+class EntityListModel;
+class ParticleListModel;
+
+// The game scene for QML: the world is advanced by one timer with fixed
+// steps and is shown by Repeaters of the entities and particles models.
+//
+// The API replaces EntityManager.qml: entities are referred by indexes
+// that are returned by generate() and getPointed().
+class GameEngine : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QAbstractItemModel *entities READ entities CONSTANT)
+    Q_PROPERTY(QAbstractItemModel *particles READ particles CONSTANT)
+    Q_PROPERTY(int entitySize READ entitySize CONSTANT)
+    Q_PROPERTY(qreal sceneWidth READ sceneWidth WRITE setSceneWidth NOTIFY sceneSizeChanged)
+    Q_PROPERTY(qreal sceneHeight READ sceneHeight WRITE setSceneHeight NOTIFY sceneSizeChanged)
+    Q_PROPERTY(bool running READ running WRITE setRunning NOTIFY runningChanged)
+    Q_PROPERTY(int entityCount READ entityCount NOTIFY entityCountChanged)
+    Q_PROPERTY(int particleCount READ particleCount NOTIFY particleCountChanged)
+    Q_PROPERTY(int winner READ winner NOTIFY winnerChanged)
+
+public:
+    explicit GameEngine(QObject *parent = 0);
+
+    QAbstractItemModel *entities() const;
+    QAbstractItemModel *particles() const;
+    int entitySize() const { return GameWorld::EntitySize; }
+    qreal sceneWidth() const { return m_world.width(); }
+    void setSceneWidth(qreal width);
+    qreal sceneHeight() const { return m_world.height(); }
+    void setSceneHeight(qreal height);
+    bool running() const { return m_running; }
+    void setRunning(bool running);
+    int entityCount() const { return m_world.entityCount(); }
+    int particleCount() const { return m_world.particleCount(); }
+    int winner() const { return m_winner; }
+
+    Q_INVOKABLE int generate(qreal x, qreal y, int player, int score);
+    Q_INVOKABLE int getPointed(const QPointF &position) const;
+    Q_INVOKABLE QPointF entityPosition(int index) const;
+    Q_INVOKABLE int entityPlayer(int index) const;
+    Q_INVOKABLE int entityScore(int index) const;
+    Q_INVOKABLE int changeScore(const QPointF &startPosition);
+    Q_INVOKABLE void createParticleObjects(qreal startX, qreal startY, qreal endX, qreal endY, int charge, int nextplayer);
+    Q_INVOKABLE void addCharge(qreal finX, qreal finY, int charge, int nextplayer);
+    Q_INVOKABLE bool checkWinner() const;
+    Q_INVOKABLE void clear();
+
+signals:
+    void sceneSizeChanged();
+    void runningChanged();
+    void entityCountChanged();
+    void particleCountChanged();
+    void winnerChanged();
+
+private slots:
+    void tick();
+
+private:
+    void catchUp();
+    void applyChanges(int changes);
+    void scheduleTick();
+    bool isEntity(int index) const;
+
+    GameWorld m_world;
+    EntityListModel *m_entities;
+    ParticleListModel *m_particles;
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    bool m_running;
+    int m_particleCount;
+    int m_winner;
+};
+
+#endif // GAMEENGINE_H
@@ -0,0 +1,139 @@
+#include "GameModels.h"
+#include "GameWorld.h"
+
+EntityListModel::EntityListModel(const GameWorld *world, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_world(world)
+{
+}
+
+int EntityListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_world->entityCount();
+}
+
+QVariant EntityListModel::data(const QModelIndex &index, int role) const
+{
+    int row = index.row();
+
+    if (!index.isValid() || row >= m_world->entityCount())
+        return QVariant();
+
+    switch (role) {
+    case PosXRole:
+        return m_world->entityX(row);
+    case PosYRole:
+        return m_world->entityY(row);
+    case PlayerRole:
+        return m_world->entityPlayer(row);
+    case ScoreRole:
+        return m_world->entityScore(row);
+    }
+
+    return QVariant();
+}
+
+QHash<int, QByteArray> EntityListModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+
+    roles[PosXRole] = "posX";
+    roles[PosYRole] = "posY";
+    roles[PlayerRole] = "player";
+    roles[ScoreRole] = "score";
+    return roles;
+}
+
+void EntityListModel::entityAdded()
+{
+    int row = m_world->entityCount() - 1;
+
+    beginInsertRows(QModelIndex(), row, row);
+    endInsertRows();
+}
+
+void EntityListModel::entitiesChanged()
+{
+    int count = m_world->entityCount();
+
+    // One signal for all rows: scores of all entities change at once.
+    if (count > 0)
+        emit dataChanged(index(0), index(count - 1), QVector<int>() << PlayerRole << ScoreRole);
+}
+
+void EntityListModel::reset()
+{
+    beginResetModel();
+    endResetModel();
+}
+
+ParticleListModel::ParticleListModel(const GameWorld *world, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_world(world)
+    , m_rows(0)
+    , m_active(0)
+{
+}
+
+int ParticleListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rows;
+}
+
+QVariant ParticleListModel::data(const QModelIndex &index, int role) const
+{
+    int row = index.row();
+    bool active = false;
+
+    if (!index.isValid() || row >= m_rows)
+        return QVariant();
+
+    active = row < m_world->particleCount();
+
+    switch (role) {
+    case PosXRole:
+        return active ? m_world->particleX(row) : 0.0f;
+    case PosYRole:
+        return active ? m_world->particleY(row) : 0.0f;
+    case ActiveRole:
+        return active;
+    }
+
+    return QVariant();
+}
+
+QHash<int, QByteArray> ParticleListModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+
+    roles[PosXRole] = "posX";
+    roles[PosYRole] = "posY";
+    roles[ActiveRole] = "active";
+    return roles;
+}
+
+void ParticleListModel::particlesChanged()
+{
+    int active = m_world->particleCount();
+    int changed = qMax(active, m_active);
+
+    if (active > m_rows) {
+        beginInsertRows(QModelIndex(), m_rows, active - 1);
+        m_rows = active;
+        endInsertRows();
+    }
+
+    // Rows that were active or are active now, the hidden tail isn't touched.
+    if (changed > 0)
+        emit dataChanged(index(0), index(changed - 1), QVector<int>() << PosXRole << PosYRole << ActiveRole);
+
+    m_active = active;
+}
+
+void ParticleListModel::reset()
+{
+    beginResetModel();
+    m_rows = 0;
+    m_active = 0;
+    endResetModel();
+}
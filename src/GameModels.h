@@ -0,0 +1,67 @@
+#ifndef GAMEMODELS_H
+#define GAMEMODELS_H
+
+#include <QAbstractListModel>
+
+class GameWorld;
+
+// Entities of the world for a Repeater, one row per entity.
+class EntityListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        PosXRole = Qt::UserRole + 1,
+        PosYRole,
+        PlayerRole,
+        ScoreRole
+    };
+
+    explicit EntityListModel(const GameWorld *world, QObject *parent = 0);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+    QHash<int, QByteArray> roleNames() const;
+
+    // Called by GameEngine after the world is changed.
+    void entityAdded();
+    void entitiesChanged();
+    void reset();
+
+private:
+    const GameWorld *m_world;
+};
+
+// Pool of particle delegates for a Repeater. Rows are never removed: the
+// first particleCount() rows are active and show particles in flight, the
+// other rows are hidden and are reused by next particles. So delegates are
+// created only when more particles are in flight than ever before.
+class ParticleListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        PosXRole = Qt::UserRole + 1,
+        PosYRole,
+        ActiveRole
+    };
+
+    explicit ParticleListModel(const GameWorld *world, QObject *parent = 0);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+    QHash<int, QByteArray> roleNames() const;
+
+    // Called by GameEngine after the world is changed.
+    void particlesChanged();
+    void reset();
+
+private:
+    const GameWorld *m_world;
+    int m_rows;
+    int m_active;   // active rows when the view was updated last time
+};
+
+#endif // GAMEMODELS_H
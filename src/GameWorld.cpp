@@ -0,0 +1,307 @@
+#include "GameWorld.h"
+
+#include <algorithm>
+#include <cmath>
+
+GameWorld::GameWorld(float width, float height)
+    : m_width(width)
+    , m_height(height)
+    , m_accumulator(0)
+    , m_scoreClock(0)
+    , m_gridDirty(true)
+    , m_columns(1)
+    , m_rows(1)
+{
+}
+
+void GameWorld::resize(float width, float height)
+{
+    m_width = width;
+    m_height = height;
+    m_gridDirty = true;
+}
+
+void GameWorld::clear()
+{
+    m_entityX.clear();
+    m_entityY.clear();
+    m_entityPlayer.clear();
+    m_entityScore.clear();
+    m_playerEntities.clear();
+
+    m_particleX.clear();
+    m_particleY.clear();
+    m_particleStartX.clear();
+    m_particleStartY.clear();
+    m_particleEndX.clear();
+    m_particleEndY.clear();
+    m_particleElapsed.clear();
+    m_particleCharge.clear();
+    m_particlePlayer.clear();
+
+    m_gridDirty = true;
+}
+
+int GameWorld::addEntity(float x, float y, int player, int score)
+{
+    m_entityX.push_back(x);
+    m_entityY.push_back(y);
+    m_entityPlayer.push_back(-1);
+    m_entityScore.push_back(score);
+    setEntityPlayer(entityCount() - 1, player);
+
+    m_gridDirty = true;
+    return entityCount() - 1;
+}
+
+int GameWorld::entityAt(float x, float y) const
+{
+    if (m_gridDirty)
+        buildGrid();
+
+    // The box of an entity is [x, x + EntitySize], so the point may be
+    // in boxes of entities with the corner in the cell and in the previous ones.
+    int firstColumn = cellColumn(x - EntitySize);
+    int lastColumn = cellColumn(x);
+    int firstRow = cellRow(y - EntitySize);
+    int lastRow = cellRow(y);
+    int found = -1;
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            int cell = row * m_columns + column;
+
+            for (int k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k) {
+                int i = m_cellEntities[k];
+
+                if (i > found
+                        && x >= m_entityX[i] && x <= m_entityX[i] + EntitySize
+                        && y >= m_entityY[i] && y <= m_entityY[i] + EntitySize)
+                    found = i;
+            }
+        }
+    }
+
+    return found;
+}
+
+int GameWorld::takeCharge(int index)
+{
+    int charge = m_entityScore[index] / 2;
+
+    m_entityScore[index] -= charge;
+    return charge;
+}
+
+int GameWorld::addCharge(float x, float y, int charge, int player)
+{
+    int index = entityAt(x, y);
+
+    if (index < 0)
+        return -1;
+
+    if (m_entityPlayer[index] == player) {
+        m_entityScore[index] += charge;
+    } else if (m_entityScore[index] < charge) {
+        m_entityScore[index] += charge;
+        setEntityPlayer(index, player);
+    } else {
+        m_entityScore[index] -= charge;
+    }
+
+    return index;
+}
+
+int GameWorld::winner() const
+{
+    int count = entityCount();
+
+    if (count == 0)
+        return 0;
+
+    for (int player = 1; player < int(m_playerEntities.size()); ++player) {
+        if (m_playerEntities[player] == count)
+            return player;
+    }
+
+    return 0;
+}
+
+int GameWorld::launchParticle(float startX, float startY, float endX, float endY, int charge, int player)
+{
+    m_particleX.push_back(startX);
+    m_particleY.push_back(startY);
+    m_particleStartX.push_back(startX);
+    m_particleStartY.push_back(startY);
+    m_particleEndX.push_back(endX);
+    m_particleEndY.push_back(endY);
+    m_particleElapsed.push_back(0);
+    m_particleCharge.push_back(charge);
+    m_particlePlayer.push_back(player);
+
+    return particleCount() - 1;
+}
+
+int GameWorld::advance(int elapsedMs)
+{
+    int changes = NoChange;
+    int steps = 0;
+
+    m_accumulator += elapsedMs;
+    steps = m_accumulator / StepMs;
+
+    if (steps > MaxStepsPerAdvance) {
+        m_accumulator -= (steps - MaxStepsPerAdvance) * StepMs;
+        steps = MaxStepsPerAdvance;
+    }
+
+    for (; steps > 0; --steps) {
+        changes |= step();
+        m_accumulator -= StepMs;
+    }
+
+    return changes;
+}
+
+int GameWorld::step()
+{
+    int changes = NoChange;
+    int count = entityCount();
+
+    m_scoreClock += StepMs;
+
+    if (m_scoreClock >= ScorePeriodMs) {
+        m_scoreClock -= ScorePeriodMs;
+
+        for (int i = 0; i < count; ++i)
+            ++m_entityScore[i];
+
+        if (count > 0)
+            changes |= EntitiesChanged;
+    }
+
+    count = particleCount();
+
+    if (count == 0)
+        return changes;
+
+    changes |= ParticlesChanged;
+
+    for (int i = 0; i < count; ++i) {
+        int elapsed = (m_particleElapsed[i] += StepMs);
+        float t = (elapsed < ParticleFlightMs) ? float(elapsed) / ParticleFlightMs : 1.0f;
+
+        m_particleX[i] = m_particleStartX[i] + (m_particleEndX[i] - m_particleStartX[i]) * t;
+        m_particleY[i] = m_particleStartY[i] + (m_particleEndY[i] - m_particleStartY[i]) * t;
+    }
+
+    // Backwards: an arrived particle is replaced by the last one, which is checked already.
+    for (int i = count - 1; i >= 0; --i) {
+        if (m_particleElapsed[i] < ParticleFlightMs)
+            continue;
+
+        if (addCharge(m_particleEndX[i], m_particleEndY[i], m_particleCharge[i], m_particlePlayer[i]) >= 0)
+            changes |= EntitiesChanged;
+
+        removeParticle(i);
+    }
+
+    return changes;
+}
+
+int GameWorld::msToNextScore() const
+{
+    int steps = (ScorePeriodMs - m_scoreClock + StepMs - 1) / StepMs;
+
+    return steps * StepMs - m_accumulator;
+}
+
+void GameWorld::setEntityPlayer(int index, int player)
+{
+    if (player < 0)
+        player = 0;
+
+    if (m_entityPlayer[index] >= 0)
+        --m_playerEntities[m_entityPlayer[index]];
+
+    if (player >= int(m_playerEntities.size()))
+        m_playerEntities.resize(player + 1, 0);
+
+    ++m_playerEntities[player];
+    m_entityPlayer[index] = player;
+}
+
+void GameWorld::removeParticle(int index)
+{
+    int last = particleCount() - 1;
+
+    if (index != last) {
+        m_particleX[index] = m_particleX[last];
+        m_particleY[index] = m_particleY[last];
+        m_particleStartX[index] = m_particleStartX[last];
+        m_particleStartY[index] = m_particleStartY[last];
+        m_particleEndX[index] = m_particleEndX[last];
+        m_particleEndY[index] = m_particleEndY[last];
+        m_particleElapsed[index] = m_particleElapsed[last];
+        m_particleCharge[index] = m_particleCharge[last];
+        m_particlePlayer[index] = m_particlePlayer[last];
+    }
+
+    m_particleX.pop_back();
+    m_particleY.pop_back();
+    m_particleStartX.pop_back();
+    m_particleStartY.pop_back();
+    m_particleEndX.pop_back();
+    m_particleEndY.pop_back();
+    m_particleElapsed.pop_back();
+    m_particleCharge.pop_back();
+    m_particlePlayer.pop_back();
+}
+
+int GameWorld::cellColumn(float x) const
+{
+    float column = std::floor(x / EntitySize);
+
+    if (column < 0)
+        return 0;
+    if (column >= m_columns)
+        return m_columns - 1;
+    return int(column);
+}
+
+int GameWorld::cellRow(float y) const
+{
+    float row = std::floor(y / EntitySize);
+
+    if (row < 0)
+        return 0;
+    if (row >= m_rows)
+        return m_rows - 1;
+    return int(row);
+}
+
+void GameWorld::buildGrid() const
+{
+    int count = entityCount();
+    int cells = 0;
+    std::vector<int> next;
+
+    m_columns = std::max(1, int(std::ceil(m_width / EntitySize)));
+    m_rows = std::max(1, int(std::ceil(m_height / EntitySize)));
+    cells = m_columns * m_rows;
+
+    // Counting sort of entities by cells keeps each cell in the order of indexes.
+    m_cellStart.assign(cells + 1, 0);
+    for (int i = 0; i < count; ++i)
+        ++m_cellStart[cellRow(m_entityY[i]) * m_columns + cellColumn(m_entityX[i]) + 1];
+
+    for (int cell = 0; cell < cells; ++cell)
+        m_cellStart[cell + 1] += m_cellStart[cell];
+
+    next.assign(m_cellStart.begin(), m_cellStart.end() - 1);
+    m_cellEntities.resize(count);
+    for (int i = 0; i < count; ++i)
+        m_cellEntities[next[cellRow(m_entityY[i]) * m_columns + cellColumn(m_entityX[i])]++] = i;
+
+    m_gridDirty = false;
+}
@@ -0,0 +1,119 @@
+#ifndef GAMEWORLD_H
+#define GAMEWORLD_H
+
+#include <vector>
+
+// Simulation of the game scene. It doesn't depend on Qt, so it is also used
+// by the headless benchmark (benchmarks/engine_tick).
+//
+// Entities (viruses) and particles in flight are kept as structure-of-arrays:
+// one vector per field, so a step walks each field linearly. Particles in
+// flight always occupy indexes [0, particleCount()); an arrived particle is
+// replaced by the last one.
+//
+// Entities don't move: the uniform grid of the hit-test is built once after
+// entities are added and is used by every entityAt() call.
+class GameWorld
+{
+public:
+    enum {
+        EntitySize = 80,        // width and height of an entity, px
+        StepMs = 16,            // fixed step of the simulation
+        ScorePeriodMs = 1000,   // each entity gets one point per period
+        ParticleFlightMs = 3000,
+        MaxStepsPerAdvance = 15 // time beyond it is dropped (e.g. after suspend)
+    };
+
+    // Result of advance() and step(): what has to be shown again.
+    enum Change {
+        NoChange = 0x0,
+        EntitiesChanged = 0x1,  // scores or players
+        ParticlesChanged = 0x2  // positions or count of particles
+    };
+
+    GameWorld(float width = 640, float height = 480);
+
+    float width() const { return m_width; }
+    float height() const { return m_height; }
+    void resize(float width, float height);
+    void clear();
+
+    // Entities
+    int addEntity(float x, float y, int player, int score);
+    int entityCount() const { return int(m_entityX.size()); }
+    float entityX(int index) const { return m_entityX[index]; }
+    float entityY(int index) const { return m_entityY[index]; }
+    int entityPlayer(int index) const { return m_entityPlayer[index]; }
+    int entityScore(int index) const { return m_entityScore[index]; }
+
+    // Index of the entity which box contains the point, -1 if there is none.
+    // If boxes overlap, the last added entity is found.
+    int entityAt(float x, float y) const;
+
+    // Takes half of the score of the entity to send it as a charge.
+    int takeCharge(int index);
+
+    // The charge of a particle arrived to the point: it is added to the
+    // entity of the same player, otherwise it is subtracted. If the charge is
+    // bigger than the score, the entity is captured and the charge is added
+    // as EntityManager.qml did. Returns the entity
+    // or -1 if there is no entity at the point.
+    int addCharge(float x, float y, int charge, int player);
+
+    // Player that owns all entities, 0 if there are several players.
+    int winner() const;
+
+    // Particles
+    int launchParticle(float startX, float startY, float endX, float endY, int charge, int player);
+    int particleCount() const { return int(m_particleX.size()); }
+    float particleX(int index) const { return m_particleX[index]; }
+    float particleY(int index) const { return m_particleY[index]; }
+
+    // Runs fixed steps for the elapsed time, the rest is kept for the next call.
+    int advance(int elapsedMs);
+    int step();
+
+    // Time until the next score increment, a timer may sleep for it if there
+    // are no particles in flight.
+    int msToNextScore() const;
+
+private:
+    void setEntityPlayer(int index, int player);
+    void removeParticle(int index);
+    int cellColumn(float x) const;
+    int cellRow(float y) const;
+    void buildGrid() const;
+
+    float m_width;
+    float m_height;
+    int m_accumulator;
+    int m_scoreClock;
+
+    std::vector<float> m_entityX;
+    std::vector<float> m_entityY;
+    std::vector<int> m_entityPlayer;
+    std::vector<int> m_entityScore;
+    std::vector<int> m_playerEntities;  // count of entities of each player
+
+    std::vector<float> m_particleX;
+    std::vector<float> m_particleY;
+    std::vector<float> m_particleStartX;
+    std::vector<float> m_particleStartY;
+    std::vector<float> m_particleEndX;
+    std::vector<float> m_particleEndY;
+    std::vector<int> m_particleElapsed;
+    std::vector<int> m_particleCharge;
+    std::vector<int> m_particlePlayer;
+
+    // Uniform grid with cells of EntitySize: entities of cell c are
+    // m_cellEntities[m_cellStart[c]] .. m_cellEntities[m_cellStart[c + 1] - 1]
+    // in the order of indexes. An entity is put to the cell of its top-left
+    // corner, positions outside of the scene are put to the border cells.
+    mutable std::vector<int> m_cellStart;
+    mutable std::vector<int> m_cellEntities;
+    mutable bool m_gridDirty;
+    mutable int m_columns;
+    mutable int m_rows;
+};
+
+#endif // GAMEWORLD_H